@@ -35,6 +35,20 @@
 // Sequence parts per quarter note resolution
 #define CONFIG_SEQUENCE_PPQN            48
 
+// Latency of scheduled gate/cv outputs in microseconds (must cover engine task period and jitter)
+#define CONFIG_OUTPUT_LATENCY_US        1500
+
+// MIDI output bandwidth used by the MIDI output engine (DIN in bytes/s, USB in event packets/s),
+// the remaining bandwidth of the ports (3125 bytes/s, 16 events per 1ms transfer) is left for clock and controllers
+#define CONFIG_MIDI_OUTPUT_BANDWIDTH_MIDI       2800
+#define CONFIG_MIDI_OUTPUT_BANDWIDTH_USBMIDI    12000
+
+// Size of the MIDI message payload pool (4 slots, each slot holds a system exclusive message of up to 1/4 of the size)
+#define CONFIG_MIDI_PAYLOAD_POOL_SIZE           512
+
+// Size of the buffer holding the serialized project chunks while saving a project in the background
+#define CONFIG_PROJECT_STAGING_BUFFER_SIZE      4096
+
 // Default UI frames per second
 #define CONFIG_DEFAULT_UI_FPS           50
 
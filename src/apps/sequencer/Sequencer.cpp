@@ -15,6 +15,7 @@
 #include "drivers/UsbH.h"
 #include "drivers/UsbMidi.h"
 #include "drivers/ClockTimer.h"
+#include "drivers/OutputTimer.h"
 #include "drivers/SdCard.h"
 
 #include "os/os.h"
@@ -59,6 +60,7 @@ inline Dac::Type getDacType() {
 }
 
 static CCMRAM_BSS ClockTimer clockTimer;
+static CCMRAM_BSS OutputTimer outputTimer;
 static CCMRAM_BSS ShiftRegister shiftRegister;
 static CCMRAM_BSS ButtonLedMatrix blm(shiftRegister, HardwareConfig::invertLeds());
 static CCMRAM_BSS Encoder encoder(HardwareConfig::reverseEncoder());
@@ -74,12 +76,14 @@ static SdCard sdCard;
 
 static fs::Volume volume(sdCard);
 
-static CCMRAM_BSS uint8_t midiMessagePayloadPool[32];
+static CCMRAM_BSS uint8_t midiMessagePayloadPool[CONFIG_MIDI_PAYLOAD_POOL_SIZE];
 
 static CCMRAM_BSS Profiler profiler;
 
+PROFILER_EVENT(bootScheduler, "BOOT SCHEDULER")
+
 static Model model;
-static CCMRAM_BSS Engine engine(model, clockTimer, adc, dac, dio, gateOutput, midi, usbMidi);
+static CCMRAM_BSS Engine engine(model, clockTimer, outputTimer, adc, dac, dio, gateOutput, midi, usbMidi);
 static CCMRAM_BSS Ui ui(model, engine, lcd, blm, encoder, model.settings());
 
 
@@ -162,6 +166,7 @@ int main(void) {
 
     shiftRegister.init();
     clockTimer.init();
+    outputTimer.init();
     blm.init();
     encoder.init();
     lcd.init();
@@ -183,5 +188,6 @@ int main(void) {
 
     System::resetWatchdog();
 
+    PROFILER_EVENT_MARK(bootScheduler)
 	os::startScheduler();
 }
@@ -0,0 +1,170 @@
+// Headless offline renderer
+// Loads a project file and runs the engine as fast as possible, streaming all output events to a file.
+
+#include "SequencerApp.h"
+
+#include "model/ProjectVersion.h"
+#include "model/ProjectChunks.h"
+
+#include "core/fs/Error.h"
+
+#include "sim/Simulator.h"
+#include "sim/TargetEventWriter.h"
+
+#include "args.hxx"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+#include <cstring>
+
+static bool loadProject(Project &project, const std::string &filename) {
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs.good()) {
+        std::cerr << "Failed to open project file '" << filename << "'" << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+    struct Source {
+        const std::vector<uint8_t> &data;
+        size_t pos;
+        fs::Error error;
+
+        void read(void *dst, size_t len) {
+            if (len > data.size() - pos) {
+                len = data.size() - pos;
+                error = fs::END_OF_FILE;
+            }
+            std::memcpy(dst, data.data() + pos, len);
+            pos += len;
+        }
+    } source { data, 0, fs::OK };
+
+    FileHeader header;
+    source.read(&header, sizeof(header));
+    if (data.size() < sizeof(header) || header.type != FileType::Project) {
+        std::cerr << "Invalid project file '" << filename << "'" << std::endl;
+        return false;
+    }
+
+    bool success;
+    if (header.version == ProjectChunks::MonolithicFileVersion) {
+        VersionedSerializedReader reader(source, ProjectVersion::Latest);
+        success = project.read(reader);
+    } else {
+        ProjectChunks::Directory directory;
+        success = ProjectChunks::readProject(project, directory, source);
+    }
+
+    // a truncated file also fails the checksum, report the read error first
+    auto error = source.error;
+    if (error == fs::OK && !success) {
+        error = fs::INVALID_CHECKSUM;
+    }
+
+    if (error != fs::OK) {
+        std::cerr << "Invalid project file '" << filename << "' (" << fs::errorToString(error) << ")" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    args::ArgumentParser parser("PER|FORMER Offline Renderer", "Renders the gate/cv/midi output of a project faster than realtime.");
+    args::HelpFlag help(parser, "help", "Display this help menu", { 'h', "help" });
+    args::ValueFlag<std::string> outputFlag(parser, "file", "Output file (default: output.csv)", { 'o', "output" }, "output.csv");
+    args::ValueFlag<int> barsFlag(parser, "bars", "Number of bars to render (default: 16)", { 'b', "bars" }, 16);
+    args::Flag binaryFlag(parser, "binary", "Write binary output instead of CSV", { "binary" });
+    args::Positional<std::string> projectArg(parser, "project", "Project file to render (default: init project)");
+
+    try {
+        parser.ParseCLI(argc, argv);
+    } catch (const args::Help &) {
+        std::cout << parser;
+        return 0;
+    } catch (const args::ParseError &e) {
+        std::cerr << e.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+
+    std::unique_ptr<SequencerApp> app;
+
+    // only update the engine, the ui is not needed for rendering
+    sim::Simulator simulator({
+        .create = [&] () {
+            app.reset(new SequencerApp());
+        },
+        .destroy = [&] () {
+            app.reset();
+        },
+        .update = [&] () {
+            app->engine.update();
+        }
+    });
+
+    // create target
+    simulator.wait(1);
+
+    auto &engine = app->engine;
+    auto &project = app->model.project();
+
+    if (projectArg) {
+        engine.suspend();
+        bool success = loadProject(project, args::get(projectArg));
+        engine.resume();
+        if (!success) {
+            return 1;
+        }
+    }
+
+    std::ofstream ofs(args::get(outputFlag), std::ios::binary);
+    if (!ofs.good()) {
+        std::cerr << "Failed to open output file '" << args::get(outputFlag) << "'" << std::endl;
+        return 1;
+    }
+
+    auto format = binaryFlag ? sim::TargetEventWriter::Format::Binary : sim::TargetEventWriter::Format::Csv;
+    sim::TargetEventWriter writer(simulator, ofs, format);
+
+    // always render from the internal clock, the clock never starts in slave mode as there is no external clock
+    project.clockSetup().setMode(ClockSetup::Mode::Master);
+    simulator.wait(1);
+
+    uint32_t endTick = std::max(0, args::get(barsFlag)) * engine.measureDivisor();
+
+    // give up if the clock does not get there in time (e.g. tempo routed to a lower value),
+    // allow for 4 times the nominal duration
+    double nominalTime = endTick * 60.0 / (project.tempo() * CONFIG_PPQN);
+    double maxTicks = 4.0 * nominalTime * 1000.0 + 1000.0;
+
+    auto start = std::chrono::steady_clock::now();
+    double startTime = simulator.ticks();
+
+    engine.clockStart();
+    while (!engine.clockRunning() || engine.tick() < endTick) {
+        if (simulator.ticks() - startTime > maxTicks) {
+            std::cerr << "Clock did not reach the end of bar " << args::get(barsFlag) << " in time, aborting" << std::endl;
+            return 1;
+        }
+        simulator.wait(1);
+    }
+    engine.clockStop();
+    simulator.wait(1);
+
+    double renderTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double projectTime = (simulator.ticks() - startTime) * 0.001;
+
+    std::cout << "Rendered " << args::get(barsFlag) << " bars (" << projectTime << "s) in " << renderTime << "s, "
+              << writer.events() << " events written to '" << args::get(outputFlag) << "'" << std::endl;
+
+    return 0;
+}
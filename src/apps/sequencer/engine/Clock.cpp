@@ -133,6 +133,11 @@ void Clock::slaveTick(int slave) {
     if (_state == State::SlaveRunning && _activeSlave == slave) {
         uint32_t divisor = _slaves[slave].divisor;
 
+        if (_slavePllEnabled) {
+            slaveTickPll(divisor);
+            return;
+        }
+
         // protect against clock rate overload
         _slaveSubTicksPending = std::min(_slaveSubTicksPending + divisor, 2 * divisor);
 
@@ -168,6 +173,35 @@ void Clock::slaveTick(int slave) {
     }
 }
 
+void Clock::slaveTickPll(uint32_t divisor) {
+    // sub ticks already generated ahead of this pulse
+    uint32_t subTicksAhead = std::min(_slaveSubTicksAhead, divisor);
+    _slaveSubTicksAhead -= subTicksAhead;
+
+    // sub ticks still pending from the previous pulse
+    uint32_t subTicksLate = _slaveSubTicksPending;
+
+    // protect against clock rate overload
+    _slaveSubTicksPending = std::min(subTicksLate + divisor - subTicksAhead, 2 * divisor);
+    subTicksLate = std::min(subTicksLate, divisor);
+
+    // default tick period to 120 bpm
+    _slavePll.update(_elapsedUs, (60.f * 1000000 * divisor) / (120 * _ppqn));
+
+    _slaveSubTickPeriodUs = std::max(uint32_t(1), uint32_t(std::lround(_slavePll.period() / divisor)));
+
+    // sub ticks of this pulse are placed on a grid starting at the filtered pulse phase, sub ticks still pending
+    // from the previous pulse are placed before that and get caught up on the next timer ticks
+    _nextSlaveSubTickUs = _slavePll.phase() + (int32_t(subTicksAhead) - int32_t(subTicksLate)) * _slaveSubTickPeriodUs;
+
+    // when locked, allow running ahead of the slave clock by up to a quarter pulse to hide jitter of late pulses
+    _slaveSubTicksAheadMax = _slavePll.locked() ? divisor / 4 : 0;
+
+    _slaveBpm = (60.f * 1000000 * divisor) / (_slavePll.period() * _ppqn);
+
+    _lastSlaveTickUs = _elapsedUs;
+}
+
 void Clock::slaveStart(int slave) {
     os::InterruptLock lock;
 
@@ -264,6 +298,12 @@ void Clock::slaveHandleMidi(int slave, uint8_t msg) {
     }
 }
 
+void Clock::slaveConfigurePll(float bandwidth) {
+    os::InterruptLock lock;
+    _slavePllEnabled = bandwidth > 0.f;
+    _slavePll.setBandwidth(bandwidth);
+}
+
 void Clock::outputConfigure(int divisor, int pulse) {
     os::InterruptLock lock;
     _output.divisor = divisor;
@@ -314,6 +354,7 @@ void Clock::onClockTimerTick() {
 
     switch (_state) {
     case State::MasterRunning: {
+        _tickTimes.record(_tick, _timer.tickTime());
         outputTick(_tick);
         ++_tick;
         _elapsedUs += _timer.period();
@@ -322,10 +363,16 @@ void Clock::onClockTimerTick() {
     case State::SlaveRunning: {
         _elapsedUs += _timer.period();
 
-        if (_slaveSubTicksPending > 0 && _elapsedUs >= _nextSlaveSubTickUs) {
+        bool subTickAvailable = _slaveSubTicksPending > 0 || _slaveSubTicksAhead < _slaveSubTicksAheadMax;
+        if (subTickAvailable && int32_t(_elapsedUs - _nextSlaveSubTickUs) >= 0) {
+            _tickTimes.record(_tick, _timer.tickTime());
             outputTick(_tick);
             ++_tick;
-            --_slaveSubTicksPending;
+            if (_slaveSubTicksPending > 0) {
+                --_slaveSubTicksPending;
+            } else {
+                ++_slaveSubTicksAhead;
+            }
             _nextSlaveSubTickUs += _slaveSubTickPeriodUs;
         }
 
@@ -341,8 +388,11 @@ void Clock::onClockTimerTick() {
 
 void Clock::resetTicks() {
     _tick = 0;
+    _tickTimes.clear();
     _tickProcessed = 0;
     _slaveSubTicksPending = 0;
+    _slaveSubTicksAhead = 0;
+    _slaveSubTicksAheadMax = 0;
     _output.nextTick = 0;
 }
 
@@ -393,6 +443,8 @@ void Clock::setupMasterTimer() {
 void Clock::setupSlaveTimer() {
     _elapsedUs = 0;
     _lastSlaveTickUs = 0;
+    _slavePll.reset();
+    _slaveSubTicksAheadMax = 0;
 
     _timer.setPeriod(SlaveTimerPeriod);
 }
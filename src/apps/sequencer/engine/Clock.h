@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Config.h"
+#include "ClockPll.h"
+#include "TickTimes.h"
 
 #include "core/utils/MovingAverage.h"
 
@@ -74,6 +76,12 @@ public:
     void slaveReset(int slave);
     void slaveHandleMidi(int slave, uint8_t msg);
 
+    // PLL bandwidth relative to the slave clock rate, 0 disables the PLL
+    void slaveConfigurePll(float bandwidth);
+    bool slavePllEnabled() const { return _slavePllEnabled; }
+    bool slaveLocked() const { return _state == State::SlaveRunning && _slavePllEnabled && _slavePll.locked(); }
+    float slaveJitter() const { return _slavePll.jitter(); }
+
     // Clock output
     void outputConfigure(int divisor, int pulse);
     void outputConfigureSwing(int swing);
@@ -83,6 +91,10 @@ public:
     Event checkEvent();
     bool checkTick(uint32_t *tick);
 
+    // time in microseconds at which the given tick was generated,
+    // the time of the latest clock timer tick if the given tick is too old to be recorded
+    uint32_t tickTime(uint32_t tick) const { return _tickTimes.time(tick, _tick, _timer.tickTime()); }
+
 private:
     enum class State {
         Idle,
@@ -106,6 +118,8 @@ private:
     void setupMasterTimer();
     void setupSlaveTimer();
 
+    void slaveTickPll(uint32_t divisor);
+
     void outputMidiMessage(uint8_t msg);
     void outputTick(uint32_t tick);
     void outputClock(bool clock);
@@ -116,6 +130,7 @@ private:
 
     static constexpr uint32_t SlaveTimerPeriod = 100; // us
     static constexpr size_t SlaveCount = 4;
+    static constexpr size_t TickTimeCount = 32;
 
     Listener *_listener = nullptr;
 
@@ -148,6 +163,7 @@ private:
 
     volatile uint32_t _tick;
     volatile uint32_t _tickProcessed;
+    TickTimes<TickTimeCount> _tickTimes;
 
     volatile int32_t _activeSlave = -1;
 
@@ -161,4 +177,9 @@ private:
     float _slaveBpmFiltered = 0.f;
     MovingAverage<float, 4> _slaveBpmAvg;
     float _slaveBpm = 0.f;
+
+    bool _slavePllEnabled = false;
+    ClockPll _slavePll;
+    uint32_t _slaveSubTicksAhead; // number of sub ticks generated ahead of the slave clock
+    uint32_t _slaveSubTicksAheadMax = 0; // maximum number of sub ticks to generate ahead of the slave clock
 };
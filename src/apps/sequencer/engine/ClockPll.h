@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+
+#include <cmath>
+#include <cstdint>
+
+// Second order phase-locked loop following the pulses of an external clock.
+// Provides a filtered pulse phase and period, removing jitter of the incoming pulses.
+// All times are in microseconds.
+class ClockPll {
+public:
+    // loop bandwidth relative to the pulse rate (0..1)
+    void setBandwidth(float bandwidth) {
+        const float damping = 0.707f;
+        float theta = bandwidth / (damping + 0.25f / damping);
+        float d = 1.f + 2.f * damping * theta + theta * theta;
+        _kp = 4.f * damping * theta / d;
+        _ki = 4.f * theta * theta / d;
+    }
+
+    void reset() {
+        _pulses = 0;
+        _lockCount = 0;
+        _error = 0.f;
+        _jitter = 0.f;
+    }
+
+    // update with a pulse received at the given time, nominal period is used until a period was measured
+    void update(uint32_t time, float nominalPeriod) {
+        if (_pulses == 0) {
+            acquire(time, nominalPeriod);
+        } else {
+            uint32_t predicted = _phase + uint32_t(std::lround(_period));
+            float error = int32_t(time - predicted);
+
+            if (_pulses == 1 || std::abs(error) > _period * AcquireThreshold) {
+                // (re-)acquire, i.e. on first measured period or tempo jumps
+                acquire(time, int32_t(time - _lastTime));
+            } else {
+                _phase = predicted + int32_t(std::lround(_kp * error));
+                _period += _ki * error;
+                _error += ErrorFilter * (error - _error);
+                _jitter += ErrorFilter * (std::abs(error) - _jitter);
+                _lockCount = std::min(_lockCount + 1, int(LockPulses));
+            }
+        }
+
+        _lastTime = time;
+        _pulses = std::min(_pulses + 1, 2);
+    }
+
+    // filtered time of the last pulse
+    uint32_t phase() const { return _phase; }
+
+    // filtered pulse period
+    float period() const { return _period; }
+
+    // mean absolute deviation of incoming pulses from the predicted phase
+    float jitter() const { return _jitter; }
+
+    bool locked() const {
+        return _lockCount >= LockPulses && std::abs(_error) < _period * LockThreshold;
+    }
+
+private:
+    void acquire(uint32_t time, float period) {
+        _phase = time;
+        _period = std::max(1.f, period);
+        _lockCount = 0;
+        _error = 0.f;
+        _jitter = 0.f;
+    }
+
+    static constexpr int LockPulses = 8;
+    static constexpr float LockThreshold = 0.05f;
+    static constexpr float AcquireThreshold = 0.25f;
+    static constexpr float ErrorFilter = 0.1f;
+
+    float _kp = 0.f;
+    float _ki = 0.f;
+
+    int _pulses = 0;
+    int _lockCount = 0;
+    uint32_t _lastTime = 0;
+    uint32_t _phase = 0;
+    float _period = 0.f;
+    float _error = 0.f;
+    float _jitter = 0.f;
+};
@@ -15,8 +15,7 @@
 static Random rng;
 
 static float evalStepShape(const CurveSequence::Step &step, bool variation, bool invert, float fraction) {
-    auto function = Curve::function(Curve::Type(variation ? step.shapeVariation() : step.shape()));
-    float value = function(fraction);
+    float value = Curve::evalLookup(Curve::Type(variation ? step.shapeVariation() : step.shape()), fraction);
     if (invert) {
         value = 1.f - value;
     }
@@ -2,7 +2,7 @@
 
 #include "TrackEngine.h"
 #include "SequenceState.h"
-#include "SortedQueue.h"
+#include "TimingWheel.h"
 #include "CurveRecorder.h"
 
 #include "model/Track.h"
@@ -30,6 +30,7 @@ public:
     virtual bool activity() const override { return _activity; }
     virtual bool gateOutput(int index) const override { return _gateOutput; }
     virtual float cvOutput(int index) const override { return _cvOutput; }
+    virtual uint32_t queueOverflow() const override { return _gateQueue.overflow(); }
     virtual float sequenceProgress() const override {
         return _currentStep < 0 ? 0.f : float(_currentStep - _sequence->firstStep()) / (_sequence->lastStep() - _sequence->firstStep());
     }
@@ -81,11 +82,5 @@ private:
         bool gate;
     };
 
-    struct GateCompare {
-        bool operator()(const Gate &a, const Gate &b) {
-            return a.tick < b.tick;
-        }
-    };
-
-    SortedQueue<Gate, 16, GateCompare> _gateQueue;
+    TimingWheel<Gate, 16> _gateQueue;
 };
@@ -13,7 +13,7 @@ void CvOutput::init() {
 
 void CvOutput::update() {
     for (int i = 0; i < Channels; ++i) {
-        _dac.setValue(i, _calibration.cvOutput(i).voltsToValue(_channels[i]));
+        _dac.setValue(i, value(i));
     }
     _dac.write();
 }
@@ -26,6 +26,11 @@ public:
         _channels[index] = value;
     }
 
+    // calibrated dac value of a channel
+    Dac::Value value(int index) const {
+        return _calibration.cvOutput(index).voltsToValue(_channels[index]);
+    }
+
 private:
     Dac &_dac;
     const Calibration &_calibration;
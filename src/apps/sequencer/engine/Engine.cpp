@@ -5,10 +5,17 @@
 
 #include "core/Debug.h"
 #include "core/midi/MidiMessage.h"
+#include "core/profiler/Profiler.h"
 
 #include "os/os.h"
 
-Engine::Engine(Model &model, ClockTimer &clockTimer, Adc &adc, Dac &dac, Dio &dio, GateOutput &gateOutput, Midi &midi, UsbMidi &usbMidi) :
+PROFILER_INTERVAL(engineUpdate, "ENGINE")
+PROFILER_INTERVAL_ARRAY(trackTick, CONFIG_TRACK_COUNT, "TRACK TICK")
+PROFILER_INTERVAL_ARRAY(trackUpdate, CONFIG_TRACK_COUNT, "TRACK UPDATE")
+PROFILER_EVENT(bootEngineReady, "BOOT ENGINE READY")
+PROFILER_EVENT(bootFirstTick, "BOOT FIRST TICK")
+
+Engine::Engine(Model &model, ClockTimer &clockTimer, OutputTimer &outputTimer, Adc &adc, Dac &dac, Dio &dio, GateOutput &gateOutput, Midi &midi, UsbMidi &usbMidi) :
     _model(model),
     _project(model.project()),
     _dio(dio),
@@ -17,6 +24,7 @@ Engine::Engine(Model &model, ClockTimer &clockTimer, Adc &adc, Dac &dac, Dio &di
     _usbMidi(usbMidi),
     _cvInput(adc),
     _cvOutput(dac, model.settings().calibration()),
+    _outputScheduler(outputTimer, dac, gateOutput),
     _clock(clockTimer),
     _midiOutputEngine(*this, model),
     _routingEngine(*this, model)
@@ -33,6 +41,7 @@ Engine::Engine(Model &model, ClockTimer &clockTimer, Adc &adc, Dac &dac, Dio &di
 void Engine::init() {
     _cvInput.init();
     _cvOutput.init();
+    _outputScheduler.init();
     _clock.init();
 
     initClock();
@@ -52,6 +61,8 @@ void Engine::update() {
         return;
     }
 
+    PROFILER_INTERVAL_SCOPE(engineUpdate)
+
     uint32_t systemTicks = os::ticks();
     float dt = (0.001f * (systemTicks - _lastSystemTicks)) / os::time::ms(1);
     _lastSystemTicks = systemTicks;
@@ -60,6 +71,13 @@ void Engine::update() {
     if (_requestSuspend != _suspended) {
         if (_requestSuspend) {
             _clock.masterStop();
+            // drop events scheduled while running, they would overwrite outputs set while suspended
+            _outputScheduler.reset();
+        } else {
+            // project might have changed while suspended
+            _routingEngine.invalidate();
+            // first resume is after the startup page loaded the project (only marked once)
+            PROFILER_EVENT_MARK(bootEngineReady)
         }
         _suspended = _requestSuspend;
     }
@@ -77,8 +95,7 @@ void Engine::update() {
 
         _cvInput.update();
         updateOverrides();
-        _cvOutput.update();
-        _gateOutput.update();
+        scheduleOutputs(_outputScheduler.now() + CONFIG_OUTPUT_LATENCY_US);
         return;
     }
 
@@ -131,14 +148,22 @@ void Engine::update() {
     uint32_t tick;
     while (_clock.checkTick(&tick)) {
         _tick = tick;
+        PROFILER_EVENT_MARK(bootFirstTick)
 
         // update play state
         updatePlayState(true);
 
-        // tick track engines
+        // tick track engines, skipping engines that have nothing to do on this tick
+        bool ticked = false;
         for (size_t trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
             auto &trackEngine = _trackEngines[trackIndex];
+            if (tick < trackEngine->nextTick()) {
+                continue;
+            }
+            ticked = true;
+            PROFILER_INTERVAL_ARRAY_BEGIN(trackTick, trackIndex)
             uint32_t result = trackEngine->tick(tick);
+            PROFILER_INTERVAL_ARRAY_END(trackTick, trackIndex)
             // update track outputs and routings if tick results in updating the track's CV output
             if (result &= TrackEngine::TickResult::CvUpdate && _trackUpdateReducers[trackIndex].update()) {
                 trackEngine->update(0.f);
@@ -148,14 +173,23 @@ void Engine::update() {
             }
         }
 
+        // schedule output changes of this tick relative to the time the tick was generated
+        if (ticked) {
+            updateTrackOutputs();
+            updateOverrides();
+            scheduleOutputs(_clock.tickTime(tick) + CONFIG_OUTPUT_LATENCY_US);
+        }
+
         // update midi outputs, force sending CC on first tick
         if (tick == 0) {
             _midiOutputEngine.update(true);
         }
     }
 
-    for (auto trackEngine : _trackEngines) {
-        trackEngine->update(dt);
+    for (size_t trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+        PROFILER_INTERVAL_ARRAY_BEGIN(trackUpdate, trackIndex)
+        _trackEngines[trackIndex]->update(dt);
+        PROFILER_INTERVAL_ARRAY_END(trackUpdate, trackIndex)
     }
 
     _midiOutputEngine.update();
@@ -164,8 +198,7 @@ void Engine::update() {
     updateOverrides();
 
     // update cv/gate outputs
-    _cvOutput.update();
-    _gateOutput.update();
+    scheduleOutputs(_outputScheduler.now() + CONFIG_OUTPUT_LATENCY_US);
 }
 
 void Engine::lock() {
@@ -380,10 +413,31 @@ void Engine::setMessageHandler(MessageHandler handler) {
 }
 
 Engine::Stats Engine::stats() const {
+    uint32_t trackQueueOverflow = 0;
+    for (auto trackEngine : _trackEngines) {
+        trackQueueOverflow += trackEngine->queueOverflow();
+    }
+
+    UsbMidi::DeviceStats usbMidiStats = {};
+    for (int device = 0; device < UsbMidi::MaxDevices; ++device) {
+        const auto &deviceStats = _usbMidi.deviceStats(device);
+        usbMidiStats.txEvents += deviceStats.txEvents;
+        usbMidiStats.txTransfers += deviceStats.txTransfers;
+        usbMidiStats.rxEvents += deviceStats.rxEvents;
+    }
+
     return {
         .uptime = os::ticks() / os::time::ms(1000),
         .midiRxOverflow = _midi.rxOverflow(),
-        .usbMidiRxOverflow = _usbMidi.rxOverflow()
+        .midiTxBytesSaved = _midi.txBytesSaved(),
+        .midiTxDrops = _midi.txDrops(),
+        .usbMidiRxOverflow = _usbMidi.rxOverflow(),
+        .usbMidiTxEvents = usbMidiStats.txEvents,
+        .usbMidiTxTransfers = usbMidiStats.txTransfers,
+        .usbMidiRxEvents = usbMidiStats.rxEvents,
+        .outputOverflow = _outputScheduler.stats().overflow,
+        .routingMidiOverflow = _routingEngine.midiOverflow(),
+        .trackQueueOverflow = trackQueueOverflow
     };
 }
 
@@ -402,14 +456,14 @@ void Engine::onClockOutput(const Clock::OutputState &state) {
 }
 
 void Engine::onClockMidi(uint8_t data) {
-    // TODO we should send a single byte with priority
+    // clock messages bypass queued messages to keep jitter low
     const auto &clockSetup = _project.clockSetup();
     if (clockSetup.midiTx()) {
-        _midi.send(MidiMessage(data));
+        _midi.sendRealTime(data);
     }
     if (clockSetup.usbTx()) {
         // always send clock on cable 0
-        _usbMidi.send(0, MidiMessage(data));
+        _usbMidi.sendRealTime(0, data);
     }
 }
 
@@ -436,10 +490,19 @@ void Engine::updateTrackSetups() {
             case Track::TrackMode::Last:
                 break;
             }
+
+            // routed values need to be written to the new track
+            _routingEngine.invalidate();
         }
 
         // update linked track engine
         _trackEngines[trackIndex]->setLinkedTrackEngine(linkedTrackEngine);
+
+        // linked track engines always precede this one
+        _trackEngines[trackIndex]->setLinkSource(false);
+        if (linkTrack >= 0) {
+            _trackEngines[linkTrack]->setLinkSource(true);
+        }
     }
 }
 
@@ -467,6 +530,13 @@ void Engine::updateTrackOutputs() {
     }
 }
 
+void Engine::scheduleOutputs(uint32_t time) {
+    _outputScheduler.scheduleGates(time, _gateOutput.gates());
+    for (int channel = 0; channel < CvOutput::Channels; ++channel) {
+        _outputScheduler.scheduleCv(time, channel, _cvOutput.value(channel));
+    }
+}
+
 void Engine::reset() {
     for (auto trackEngine : _trackEngines) {
         trackEngine->reset();
@@ -476,6 +546,11 @@ void Engine::reset() {
 }
 
 void Engine::updatePlayState(bool ticked) {
+    // sequences of requested patterns might not be loaded yet
+    if (_playStateHeld) {
+        return;
+    }
+
     auto &playState = _project.playState();
     auto &songState = playState.songState();
     const auto &song = _project.song();
@@ -928,6 +1003,24 @@ void Engine::updateClockSetup() {
     _clock.slaveConfigure(ClockSourceMidi, CONFIG_PPQN / 24, clockSetup.midiRx());
     _clock.slaveConfigure(ClockSourceUsbMidi, CONFIG_PPQN / 24, clockSetup.usbRx());
 
+    // Configure slave clock PLL
+    switch (clockSetup.pllBandwidth()) {
+    case ClockSetup::PllBandwidth::Off:
+        _clock.slaveConfigurePll(0.f);
+        break;
+    case ClockSetup::PllBandwidth::Low:
+        _clock.slaveConfigurePll(0.01f);
+        break;
+    case ClockSetup::PllBandwidth::Medium:
+        _clock.slaveConfigurePll(0.03f);
+        break;
+    case ClockSetup::PllBandwidth::High:
+        _clock.slaveConfigurePll(0.1f);
+        break;
+    case ClockSetup::PllBandwidth::Last:
+        break;
+    }
+
     // Update from clock input signal
     bool resetInput = _dio.resetInput.get();
     bool running = _clock.isRunning();
@@ -10,6 +10,7 @@
 #include "MidiCvTrackEngine.h"
 #include "CvInput.h"
 #include "CvOutput.h"
+#include "OutputScheduler.h"
 #include "RoutingEngine.h"
 #include "MidiOutputEngine.h"
 #include "MidiPort.h"
@@ -25,6 +26,7 @@
 #include "drivers/Dio.h"
 #include "drivers/GateOutput.h"
 #include "drivers/Midi.h"
+#include "drivers/OutputTimer.h"
 #include "drivers/UsbMidi.h"
 
 #include <array>
@@ -54,10 +56,18 @@ public:
     struct Stats {
         uint32_t uptime;
         uint32_t midiRxOverflow;
+        uint32_t midiTxBytesSaved;
+        uint32_t midiTxDrops;
         uint32_t usbMidiRxOverflow;
+        uint32_t usbMidiTxEvents;
+        uint32_t usbMidiTxTransfers;
+        uint32_t usbMidiRxEvents;
+        uint32_t outputOverflow;
+        uint32_t routingMidiOverflow;
+        uint32_t trackQueueOverflow;
     };
 
-    Engine(Model &model, ClockTimer &clockTimer, Adc &adc, Dac &dac, Dio &dio, GateOutput &gateOutput, Midi &midi, UsbMidi &usbMidi);
+    Engine(Model &model, ClockTimer &clockTimer, OutputTimer &outputTimer, Adc &adc, Dac &dac, Dio &dio, GateOutput &gateOutput, Midi &midi, UsbMidi &usbMidi);
 
     void init();
     void update();
@@ -74,6 +84,11 @@ public:
     void resume();
     bool isSuspended() const { return _suspended; }
 
+    // holding the play state defers all mute, pattern and song changes, requests are kept and executed once
+    // released. Used while sequences of the project are still being loaded in the background.
+    void holdPlayState(bool hold) { _playStateHeld = hold; }
+    bool isPlayStateHeld() const { return _playStateHeld; }
+
     // clock control
     void togglePlay(bool shift = false);
     void clockStart();
@@ -110,6 +125,8 @@ public:
     const CvOutput &cvOutput() const { return _cvOutput; }
     const uint8_t gateOutput() const { return _gateOutput.gates(); }
 
+    const OutputScheduler &outputScheduler() const { return _outputScheduler; }
+
     // gate overrides
     bool gateOutputOverride() const { return _gateOutputOverride; }
     void setGateOutputOverride(bool enabled) { _gateOutputOverride = enabled; }
@@ -167,6 +184,7 @@ private:
 
     void updateTrackSetups();
     void updateTrackOutputs();
+    void scheduleOutputs(uint32_t time);
     void reset();
     void updatePlayState(bool ticked);
     void updateOverrides();
@@ -192,6 +210,7 @@ private:
 
     CvInput _cvInput;
     CvOutput _cvOutput;
+    OutputScheduler _outputScheduler;
 
     Clock _clock;
     TapTempo _tapTempo;
@@ -219,6 +238,8 @@ private:
     volatile uint32_t _requestSuspend = 0;
     volatile uint32_t _suspended = 0;
 
+    volatile bool _playStateHeld = false;
+
     uint32_t _tick = 0;
 
     uint32_t _lastSystemTicks = 0;
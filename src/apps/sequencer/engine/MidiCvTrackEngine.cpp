@@ -159,6 +159,9 @@ void MidiCvTrackEngine::updateArpeggiator() {
         resetVoices();
         _arpeggiatorEnabled = false;
     }
+
+    // only the arpeggiator needs to be ticked
+    _nextTick = _arpeggiatorEnabled ? 0 : 0xffffffff;
 }
 
 void MidiCvTrackEngine::tickArpeggiator(uint32_t tick) {
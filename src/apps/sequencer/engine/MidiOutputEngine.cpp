@@ -5,11 +5,19 @@
 #include "model/MidiOutput.h"
 
 #include "core/midi/MidiMessage.h"
+#include "core/profiler/Profiler.h"
+
+PROFILER_INTERVAL(midiOutputUpdate, "MIDI OUTPUT")
 
 MidiOutputEngine::MidiOutputEngine(Engine &engine, Model &model):
     _engine(engine),
     _midiOutput(model.project().midiOutput())
 {
+    _portBudgets[int(MidiPort::Midi)] = { 0, CONFIG_MIDI_OUTPUT_BANDWIDTH_MIDI, 12 };
+    _portBudgets[int(MidiPort::UsbMidi)] = { 0, CONFIG_MIDI_OUTPUT_BANDWIDTH_USBMIDI, 16 };
+    for (auto &budget : _portBudgets) {
+        budget.tokens = budget.burst * 1000;
+    }
 }
 
 void MidiOutputEngine::reset() {
@@ -19,17 +27,14 @@ void MidiOutputEngine::reset() {
 }
 
 void MidiOutputEngine::update(bool forceSendCC) {
-    // determine the rate for sending MIDI CC events:
-    // 3250 bytes per second
-    // 3 bytes per message
-    // 16 outputs
-    // gives roughly 67 events per second per track
-    // be conservative and make this 50 events per second
-    bool sendCC = forceSendCC;
+    PROFILER_INTERVAL_SCOPE(midiOutputUpdate)
+
+    // refill bandwidth budgets
     uint32_t ticks = os::ticks();
-    if (ticks >= _lastSendCCTicks + os::time::ms(1000 / 50)) {
-        sendCC = true;
-        _lastSendCCTicks = ticks;
+    uint32_t elapsed = (ticks - _lastUpdateTicks) / os::time::ms(1);
+    _lastUpdateTicks += elapsed * os::time::ms(1);
+    for (auto &budget : _portBudgets) {
+        budget.refill(std::min(elapsed, uint32_t(1000)));
     }
 
     for (int outputIndex = 0; outputIndex < CONFIG_MIDI_OUTPUT_COUNT; ++outputIndex) {
@@ -92,12 +97,9 @@ void MidiOutputEngine::update(bool forceSendCC) {
             outputState.clearRequest(OutputState::NoteOn | OutputState::NoteOff);
         }
 
-        // send control change requests
-        if (sendCC && outputState.hasRequest(OutputState::ControlChange)) {
-            sendMidi(port, MidiMessage::makeControlChange(channel, output.controlNumber(), outputState.control));
-            outputState.clearRequest(OutputState::ControlChange);
-        }
     }
+
+    sendControlChanges(forceSendCC);
 }
 
 void MidiOutputEngine::sendGate(int trackIndex, bool gate) {
@@ -168,6 +170,56 @@ void MidiOutputEngine::sendMalekkoSaveHandshake(int channel) {
     sendMidi(MidiPort::Midi, MidiMessage::makeControlChange(channel, 16, 127));
 }
 
+void MidiOutputEngine::sendControlChanges(bool force) {
+    // collect pending control changes, larger changes and changes that waited longer go first
+    std::array<uint8_t, CONFIG_MIDI_OUTPUT_COUNT> candidates;
+    std::array<int, CONFIG_MIDI_OUTPUT_COUNT> priorities;
+    int candidateCount = 0;
+
+    for (int outputIndex = 0; outputIndex < CONFIG_MIDI_OUTPUT_COUNT; ++outputIndex) {
+        const auto &output = _midiOutput.output(outputIndex);
+        const auto &outputState = _outputStates[outputIndex];
+
+        if (!output.isControlChangeEvent() || !(outputState.requests & OutputState::ControlChange)) {
+            continue;
+        }
+
+        int delta = outputState.sentControl < 0 ? 128 : std::abs(outputState.control - outputState.sentControl);
+        if (!force && delta < output.controlDelta()) {
+            continue;
+        }
+
+        int priority = delta + outputState.controlAge;
+        int index = candidateCount++;
+        while (index > 0 && priorities[index - 1] < priority) {
+            candidates[index] = candidates[index - 1];
+            priorities[index] = priorities[index - 1];
+            --index;
+        }
+        candidates[index] = outputIndex;
+        priorities[index] = priority;
+    }
+
+    // send as many control changes as the port bandwidth allows
+    for (int i = 0; i < candidateCount; ++i) {
+        int outputIndex = candidates[i];
+        const auto &output = _midiOutput.output(outputIndex);
+        auto &outputState = _outputStates[outputIndex];
+
+        MidiPort port = MidiPort(output.target().port());
+        auto message = MidiMessage::makeControlChange(output.target().channel(), output.controlNumber(), outputState.control);
+
+        if (force || _portBudgets[int(port)].available(messageCost(port, message))) {
+            sendMidi(port, message);
+            outputState.sentControl = outputState.control;
+            outputState.controlAge = 0;
+            outputState.clearRequest(OutputState::ControlChange);
+        } else if (outputState.controlAge < 1000) {
+            ++outputState.controlAge;
+        }
+    }
+}
+
 void MidiOutputEngine::resetOutput(int outputIndex) {
     auto &outputState = _outputStates[outputIndex];
 
@@ -190,6 +242,14 @@ void MidiOutputEngine::resetOutput(int outputIndex) {
 
 void MidiOutputEngine::sendMidi(MidiPort port, const MidiMessage &message) {
     // MidiMessage::dump(message);
+    if (size_t(port) < _portBudgets.size()) {
+        _portBudgets[int(port)].consume(messageCost(port, message));
+    }
     // always use cable 0
     _engine.sendMidi(port, 0, message);
 }
+
+int MidiOutputEngine::messageCost(MidiPort port, const MidiMessage &message) {
+    // DIN sends bytes (without taking running status into account), USB sends one event packet per message
+    return port == MidiPort::Midi ? message.length() : 1;
+}
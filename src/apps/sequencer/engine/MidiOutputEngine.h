@@ -7,6 +7,7 @@
 #include "model/MidiConfig.h"
 #include "model/MidiOutput.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 
@@ -48,6 +49,8 @@ private:
         int8_t slide;
         int8_t velocity;
         int8_t control;
+        int8_t sentControl;
+        uint16_t controlAge;
 
         int8_t activeNote;
 
@@ -59,6 +62,8 @@ private:
             slide = 0;
             velocity = 100;
             control = 0;
+            sentControl = -1;
+            controlAge = 0;
 
             activeNote = -1;
         };
@@ -68,12 +73,29 @@ private:
         bool hasRequest(uint8_t request) { return requests & request; }
     };
 
+    // token bucket limiting the bandwidth used on a MIDI port,
+    // tokens are kept in 1/1000 units (bytes on DIN, event packets on USB)
+    struct PortBudget {
+        int32_t tokens;
+        int32_t rate;   // units per second
+        int32_t burst;  // max units sent at once
+
+        void refill(uint32_t ms) { tokens = std::min(tokens + rate * int32_t(ms), burst * 1000); }
+        bool available(int cost) const { return tokens >= cost * 1000; }
+        void consume(int cost) { tokens = std::max(tokens - cost * 1000, -burst * 1000); }
+    };
+
+    void sendControlChanges(bool force);
+
     void resetOutput(int outputIndex);
 
     void sendMidi(MidiPort port, const MidiMessage &message);
 
+    static int messageCost(MidiPort port, const MidiMessage &message);
+
     Engine &_engine;
     const MidiOutput &_midiOutput;
     std::array<OutputState, CONFIG_MIDI_OUTPUT_COUNT> _outputStates;
-    uint32_t _lastSendCCTicks = 0;
+    std::array<PortBudget, 2> _portBudgets;
+    uint32_t _lastUpdateTicks = 0;
 };
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Config.h"
+
+#include "MidiPort.h"
+
+#include "model/Routing.h"
+
+#include "core/midi/MidiMessage.h"
+
+#include <algorithm>
+#include <array>
+
+#include <cstdint>
+
+// Index for resolving incoming MIDI messages to the routes they may feed.
+// Routes are kept as bit masks keyed by (port, message type, CC/note number).
+// Channels are not part of the key and need to be matched by the caller.
+class MidiRouteIndex {
+public:
+    typedef uint16_t RouteMask;
+
+    static_assert(CONFIG_ROUTE_COUNT <= sizeof(RouteMask) * 8, "route bits do not fit");
+
+    MidiRouteIndex() {
+        clear();
+    }
+
+    void clear() {
+        for (auto &control : _control) {
+            control.fill(0);
+        }
+        for (auto &note : _note) {
+            note.fill(0);
+        }
+        _pitchBend.fill(0);
+    }
+
+    void add(int routeIndex, const Routing::MidiSource &midiSource) {
+        int port = int(midiSource.source().port());
+        if (port >= PortCount) {
+            return;
+        }
+
+        RouteMask routeBit = RouteMask(1 << routeIndex);
+
+        switch (midiSource.event()) {
+        case Routing::MidiSource::Event::ControlAbsolute:
+        case Routing::MidiSource::Event::ControlRelative:
+            _control[port][midiSource.controlNumber()] |= routeBit;
+            break;
+        case Routing::MidiSource::Event::PitchBend:
+            _pitchBend[port] |= routeBit;
+            break;
+        case Routing::MidiSource::Event::NoteMomentary:
+        case Routing::MidiSource::Event::NoteToggle:
+        case Routing::MidiSource::Event::NoteVelocity:
+            _note[port][midiSource.note()] |= routeBit;
+            break;
+        case Routing::MidiSource::Event::NoteRange:
+            for (int note = midiSource.note(); note < std::min(128, midiSource.note() + midiSource.noteRange()); ++note) {
+                _note[port][note] |= routeBit;
+            }
+            break;
+        case Routing::MidiSource::Event::Last:
+            break;
+        }
+    }
+
+    RouteMask lookup(MidiPort port, const MidiMessage &message) const {
+        int portIndex = int(port);
+        if (portIndex >= PortCount) {
+            return 0;
+        }
+
+        if (message.isControlChange()) {
+            return _control[portIndex][message.controlNumber() & 0x7f];
+        } else if (message.isNoteOn() || message.isNoteOff()) {
+            return _note[portIndex][message.note() & 0x7f];
+        } else if (message.isPitchBend()) {
+            return _pitchBend[portIndex];
+        }
+
+        return 0;
+    }
+
+private:
+    static constexpr int PortCount = int(Types::MidiPort::Last);
+
+    std::array<std::array<RouteMask, 128>, PortCount> _control;
+    std::array<std::array<RouteMask, 128>, PortCount> _note;
+    std::array<RouteMask, PortCount> _pitchBend;
+};
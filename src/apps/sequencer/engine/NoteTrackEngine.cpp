@@ -62,14 +62,9 @@ static int evalStepLength(const NoteSequence::Step &step, int lengthBias) {
     return length;
 }
 
-// evaluate transposition
-static int evalTransposition(const Scale &scale, int octave, int transpose) {
-    return octave * scale.notesPerOctave() + transpose;
-}
-
-// evaluate note voltage
-static float evalStepNote(const NoteSequence::Step &step, int probabilityBias, const Scale &scale, int rootNote, int octave, int transpose, bool useVariation = true) {
-    int note = step.note() + evalTransposition(scale, octave, transpose);
+// evaluate note voltage (cache needs to be setup with scale, root note, octave and transpose)
+static float evalStepNote(const NoteSequence::Step &step, int probabilityBias, NoteVoltageCache &cache, bool useVariation = true) {
+    int note = step.note() + cache.transposition();
     int probability = clamp(step.noteVariationProbability() + probabilityBias, -1, NoteSequence::NoteVariationProbability::Max);
     if (useVariation && int(rng.nextRange(NoteSequence::NoteVariationProbability::Range)) <= probability) {
         int offset = step.noteVariationRange() == 0 ? 0 : rng.nextRange(std::abs(step.noteVariationRange()) + 1);
@@ -78,7 +73,7 @@ static float evalStepNote(const NoteSequence::Step &step, int probabilityBias, c
         }
         note = NoteSequence::Note::clamp(note + offset);
     }
-    return scale.noteToVolts(note) + (scale.isChromatic() ? rootNote : 0) * (1.f / 12.f);
+    return cache.volts(note);
 }
 
 void NoteTrackEngine::reset() {
@@ -94,6 +89,7 @@ void NoteTrackEngine::reset() {
     _gateQueue.clear();
     _cvQueue.clear();
     _recordHistory.clear();
+    _nextTick = 0;
 
     changePattern();
 }
@@ -102,6 +98,7 @@ void NoteTrackEngine::restart() {
     _freeRelativeTick = 0;
     _sequenceState.reset();
     _currentStep = -1;
+    _nextTick = 0;
 }
 
 TrackEngine::TickResult NoteTrackEngine::tick(uint32_t tick) {
@@ -184,6 +181,8 @@ TrackEngine::TickResult NoteTrackEngine::tick(uint32_t tick) {
         _cvQueue.pop();
     }
 
+    updateNextTick(tick);
+
     return result;
 }
 
@@ -191,6 +190,13 @@ void NoteTrackEngine::update(float dt) {
     bool running = _engine.state().running();
     bool recording = _engine.state().recording();
 
+    // pick up sequence changes (divisor, reset measure) made since the last tick
+    if (running) {
+        uint32_t nextTick = _nextTick;
+        updateNextTick(_engine.tick());
+        _nextTick = std::min(_nextTick, nextTick);
+    }
+
     const auto &sequence = *_sequence;
     const auto &scale = sequence.selectedScale(_model.project().scale());
     int rootNote = sequence.selectedRootNote(_model.project().rootNote());
@@ -247,10 +253,11 @@ void NoteTrackEngine::update(float dt) {
 
     if (stepMonitoring) {
         const auto &step = sequence.step(_monitorStepIndex);
-        setOverride(evalStepNote(step, 0, scale, rootNote, octave, transpose, false));
+        _noteVoltageCache.setup(scale, rootNote, octave, transpose);
+        setOverride(evalStepNote(step, 0, _noteVoltageCache, false));
     } else if (liveMonitoring && _recordHistory.isNoteActive()) {
-        int note = noteFromMidiNote(_recordHistory.activeNote()) + evalTransposition(scale, octave, transpose);
-        setOverride(scale.noteToVolts(note) + (scale.isChromatic() ? rootNote : 0) * (1.f / 12.f));
+        _noteVoltageCache.setup(scale, rootNote, octave, transpose);
+        setOverride(_noteVoltageCache.volts(noteFromMidiNote(_recordHistory.activeNote()) + _noteVoltageCache.transposition()));
     } else {
         clearOverride();
     }
@@ -289,6 +296,34 @@ void NoteTrackEngine::setMonitorStep(int index) {
     }
 }
 
+void NoteTrackEngine::updateNextTick(uint32_t tick) {
+    // linked and free running sequences are ticked on every tick
+    uint32_t nextTick = tick + 1;
+
+    if (!_linkedTrackEngine && _noteTrack.playMode() == Types::PlayMode::Aligned) {
+        const auto &sequence = *_sequence;
+        uint32_t divisor = sequence.divisor() * (CONFIG_PPQN / CONFIG_SEQUENCE_PPQN);
+        uint32_t resetDivisor = sequence.resetMeasure() * _engine.measureDivisor();
+        uint32_t relativeTick = resetDivisor == 0 ? tick : tick % resetDivisor;
+
+        // next step or reset measure
+        nextTick = tick + divisor - relativeTick % divisor;
+        if (resetDivisor != 0) {
+            nextTick = std::min(nextTick, tick + resetDivisor - relativeTick);
+        }
+
+        // next queued gate/cv
+        if (!_gateQueue.empty()) {
+            nextTick = std::min(nextTick, _gateQueue.front().tick);
+        }
+        if (!_cvQueue.empty()) {
+            nextTick = std::min(nextTick, _cvQueue.front().tick);
+        }
+    }
+
+    _nextTick = nextTick;
+}
+
 void NoteTrackEngine::triggerStep(uint32_t tick, uint32_t divisor) {
     int octave = _noteTrack.octave();
     int transpose = _noteTrack.transpose();
@@ -330,7 +365,8 @@ void NoteTrackEngine::triggerStep(uint32_t tick, uint32_t divisor) {
     if (stepGate || _noteTrack.cvUpdateMode() == NoteTrack::CvUpdateMode::Always) {
         const auto &scale = evalSequence.selectedScale(_model.project().scale());
         int rootNote = evalSequence.selectedRootNote(_model.project().rootNote());
-        _cvQueue.push({ Groove::applySwing(tick + gateOffset, swing()), evalStepNote(step, _noteTrack.noteProbabilityBias(), scale, rootNote, octave, transpose), step.slide() });
+        _noteVoltageCache.setup(scale, rootNote, octave, transpose);
+        _cvQueue.push({ Groove::applySwing(tick + gateOffset, swing()), evalStepNote(step, _noteTrack.noteProbabilityBias(), _noteVoltageCache), step.slide() });
     }
 }
 
@@ -2,7 +2,8 @@
 
 #include "TrackEngine.h"
 #include "SequenceState.h"
-#include "SortedQueue.h"
+#include "NoteVoltageCache.h"
+#include "TimingWheel.h"
 #include "Groove.h"
 #include "RecordHistory.h"
 #include "StepRecorder.h"
@@ -33,6 +34,7 @@ public:
     virtual bool activity() const override { return _activity; }
     virtual bool gateOutput(int index) const override { return _gateOutput; }
     virtual float cvOutput(int index) const override { return _cvOutput; }
+    virtual uint32_t queueOverflow() const override { return _gateQueue.overflow() + _cvQueue.overflow(); }
     virtual float sequenceProgress() const override {
         return _currentStep < 0 ? 0.f : float(_currentStep - _sequence->firstStep()) / (_sequence->lastStep() - _sequence->firstStep());
     }
@@ -46,6 +48,7 @@ public:
     void setMonitorStep(int index);
 
 private:
+    void updateNextTick(uint32_t tick);
     void triggerStep(uint32_t tick, uint32_t divisor);
     void recordStep(uint32_t tick, uint32_t divisor);
     int noteFromMidiNote(uint8_t midiNote) const;
@@ -66,6 +69,8 @@ private:
     int _currentStep;
     bool _prevCondition;
 
+    NoteVoltageCache _noteVoltageCache;
+
     int _monitorStepIndex = -1;
 
     RecordHistory _recordHistory;
@@ -83,13 +88,8 @@ private:
         bool gate;
     };
 
-    struct GateCompare {
-        bool operator()(const Gate &a, const Gate &b) {
-            return a.tick < b.tick;
-        }
-    };
-
-    SortedQueue<Gate, 16, GateCompare> _gateQueue;
+    // up to 4 retriggers per step plus events pending from the previous step
+    TimingWheel<Gate, 32> _gateQueue;
 
     struct Cv {
         uint32_t tick;
@@ -97,11 +97,5 @@ private:
         bool slide;
     };
 
-    struct CvCompare {
-        bool operator()(const Cv &a, const Cv &b) {
-            return a.tick < b.tick;
-        }
-    };
-
-    SortedQueue<Cv, 16, CvCompare> _cvQueue;
+    TimingWheel<Cv, 16> _cvQueue;
 };
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "model/NoteSequence.h"
+#include "model/Scale.h"
+#include "model/UserScale.h"
+
+#include <array>
+#include <bitset>
+
+#include <cstdint>
+
+// Caches the conversion of notes to voltages for a given scale, root note, octave and transpose.
+// Entries are indexed by the untransposed note (range of NoteSequence::Note) and are computed on
+// first use. The cache is invalidated whenever any of the parameters (or a user scale) change.
+class NoteVoltageCache {
+public:
+    // Sets up the conversion parameters. Invalidates the cache if they changed.
+    void setup(const Scale &scale, int rootNote, int octave, int transpose) {
+        uint32_t userScaleRevision = UserScale::revision();
+        if (&scale == _scale && rootNote == _rootNote && octave == _octave && transpose == _transpose && userScaleRevision == _userScaleRevision) {
+            return;
+        }
+
+        _scale = &scale;
+        _rootNote = rootNote;
+        _octave = octave;
+        _transpose = transpose;
+        _userScaleRevision = userScaleRevision;
+
+        _transposition = octave * scale.notesPerOctave() + transpose;
+        _rootVolts = (scale.isChromatic() ? rootNote : 0) * (1.f / 12.f);
+        _valid.reset();
+    }
+
+    // Transposition (in notes) resulting from octave and transpose.
+    int transposition() const { return _transposition; }
+
+    // Returns the voltage of a transposed note.
+    float volts(int note) {
+        int index = note - _transposition - NoteSequence::Note::Min;
+        if (index < 0 || index >= Size) {
+            return _scale->noteToVolts(note) + _rootVolts;
+        }
+        if (!_valid[index]) {
+            _volts[index] = _scale->noteToVolts(note) + _rootVolts;
+            _valid.set(index);
+        }
+        return _volts[index];
+    }
+
+private:
+    static constexpr int Size = NoteSequence::Note::Max - NoteSequence::Note::Min + 1;
+
+    const Scale *_scale = nullptr;
+    int _rootNote = 0;
+    int _octave = 0;
+    int _transpose = 0;
+    uint32_t _userScaleRevision = 0;
+
+    int _transposition = 0;
+    float _rootVolts = 0.f;
+
+    std::bitset<Size> _valid;
+    std::array<float, Size> _volts;
+};
@@ -0,0 +1,90 @@
+#include "OutputScheduler.h"
+
+#include "os/os.h"
+
+#include <algorithm>
+
+OutputScheduler::OutputScheduler(OutputTimer &timer, Dac &dac, GateOutput &gateOutput) :
+    _timer(timer),
+    _dac(dac),
+    _gateOutput(gateOutput)
+{
+    _scheduledCv.fill(0);
+}
+
+void OutputScheduler::init() {
+    _timer.setListener(this);
+    reset();
+}
+
+void OutputScheduler::reset() {
+    os::InterruptLock lock;
+    _timer.cancel();
+    _queue.clear();
+    // discarded events might have been scheduled, queue the next values even if they are unchanged
+    _resync = ResyncAll;
+}
+
+void OutputScheduler::scheduleGates(uint32_t time, uint8_t gates) {
+    if (gates != _scheduledGates || (_resync & ResyncGates)) {
+        _scheduledGates = gates;
+        _resync &= ~ResyncGates;
+        push({ time, Event::Gates, 0, gates });
+    }
+}
+
+void OutputScheduler::scheduleCv(uint32_t time, int channel, Dac::Value value) {
+    if (value != _scheduledCv[channel] || (_resync & (1 << channel))) {
+        _scheduledCv[channel] = value;
+        _resync &= ~(1 << channel);
+        push({ time, Event::Cv, uint8_t(channel), value });
+    }
+}
+
+void OutputScheduler::push(const Event &event) {
+    os::InterruptLock lock;
+
+    if (_queue.size() >= QueueSize - 1) {
+        // queue is full, flush all queued events in time order and apply the event immediately
+        // rather than losing it, so older events cannot overwrite it afterwards
+        ++_stats.overflow;
+        _timer.cancel();
+        while (!_queue.empty()) {
+            apply(_queue.front());
+            _queue.pop();
+        }
+        apply(event);
+        return;
+    }
+
+    _queue.push(event);
+    _timer.schedule(_queue.front().time);
+}
+
+void OutputScheduler::apply(const Event &event) {
+    switch (event.kind) {
+    case Event::Gates:
+        _gateOutput.write(event.value);
+        break;
+    case Event::Cv:
+        _dac.setValue(event.channel, event.value);
+        _dac.write(event.channel);
+        break;
+    }
+    ++_stats.events;
+}
+
+void OutputScheduler::onOutputTimer() {
+    uint32_t time = _timer.now();
+
+    while (!_queue.empty() && int32_t(_queue.front().time - time) <= 0) {
+        const auto &event = _queue.front();
+        _stats.maxLateness = std::max(_stats.maxLateness, time - event.time);
+        apply(event);
+        _queue.pop();
+    }
+
+    if (!_queue.empty()) {
+        _timer.schedule(_queue.front().time);
+    }
+}
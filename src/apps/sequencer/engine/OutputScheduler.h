@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Config.h"
+
+#include "SortedQueue.h"
+
+#include "drivers/Dac.h"
+#include "drivers/GateOutput.h"
+#include "drivers/OutputTimer.h"
+
+#include <array>
+
+#include <cstdint>
+
+// Applies timestamped gate/cv changes to the hardware from the output timer interrupt.
+// The engine runs at a 1ms rate and pushes output changes with the time of the clock tick
+// that caused them plus a constant latency, which removes the 1ms jitter of the engine task.
+class OutputScheduler : private OutputTimer::Listener {
+public:
+    static constexpr int CvChannels = CONFIG_CV_OUTPUT_CHANNELS;
+
+    struct Stats {
+        uint32_t events;
+        uint32_t overflow;
+        uint32_t maxLateness;   // us
+    };
+
+    OutputScheduler(OutputTimer &timer, Dac &dac, GateOutput &gateOutput);
+
+    void init();
+
+    // discard all pending events, the next scheduled values are queued even if unchanged
+    void reset();
+
+    // current time in microseconds
+    uint32_t now() const { return _timer.now(); }
+
+    // schedule output changes, only values differing from the last scheduled ones are queued
+    void scheduleGates(uint32_t time, uint8_t gates);
+    void scheduleCv(uint32_t time, int channel, Dac::Value value);
+
+    const Stats &stats() const { return _stats; }
+
+private:
+    struct Event {
+        enum Kind : uint8_t {
+            Gates,
+            Cv,
+        };
+
+        uint32_t time;
+        Kind kind;
+        uint8_t channel;
+        uint16_t value;
+    };
+
+    struct EventCompare {
+        bool operator()(const Event &a, const Event &b) {
+            return int32_t(a.time - b.time) < 0;
+        }
+    };
+
+    static constexpr size_t QueueSize = 64;
+
+    // bits of _resync, one per cv channel plus one for the gates
+    static constexpr uint32_t ResyncGates = 1 << CvChannels;
+    static constexpr uint32_t ResyncAll = (ResyncGates << 1) - 1;
+
+    void push(const Event &event);
+    void apply(const Event &event);
+
+    // OutputTimer::Listener
+    virtual void onOutputTimer() override;
+
+    OutputTimer &_timer;
+    Dac &_dac;
+    GateOutput &_gateOutput;
+
+    SortedQueue<Event, QueueSize, EventCompare> _queue;
+
+    uint8_t _scheduledGates = 0;
+    std::array<Dac::Value, CvChannels> _scheduledCv;
+    uint32_t _resync = 0;
+
+    Stats _stats = {};
+};
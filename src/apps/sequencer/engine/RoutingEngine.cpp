@@ -3,6 +3,15 @@
 #include "Engine.h"
 #include "MidiUtils.h"
 
+#include "core/profiler/Profiler.h"
+
+#include <cmath>
+
+PROFILER_INTERVAL(routingUpdate, "ROUTING")
+
+// minimum change of a normalized route value before writing its target
+static const float ChangeThreshold = 1.f / 4096.f;
+
 // for allowing direct mapping
 static_assert(int(MidiPort::Midi) == int(Types::MidiPort::Midi), "invalid mapping");
 static_assert(int(MidiPort::UsbMidi) == int(Types::MidiPort::UsbMidi), "invalid mapping");
@@ -13,6 +22,8 @@ RoutingEngine::RoutingEngine(Engine &engine, Model &model) :
 {}
 
 void RoutingEngine::update() {
+    PROFILER_INTERVAL_SCOPE(routingUpdate)
+
     updateSources();
     updateSinks();
 }
@@ -20,19 +31,22 @@ void RoutingEngine::update() {
 bool RoutingEngine::receiveMidi(MidiPort port, const MidiMessage &message) {
     bool consumed = false;
 
-    for (int routeIndex = 0; routeIndex < CONFIG_ROUTE_COUNT; ++routeIndex) {
+    auto routes = _midiRouteIndex.lookup(port, message);
+
+    while (routes) {
+        int routeIndex = __builtin_ctz(routes);
+        routes &= routes - 1;
+
         const auto &route = _routing.route(routeIndex);
-        if (route.active() &&
-            route.source() == Routing::Source::Midi &&
-            MidiUtils::matchSource(port, message, route.midiSource().source())
-        ) {
+        if (MidiUtils::matchSource(port, message, route.midiSource().source())) {
             const auto &midiSource = route.midiSource();
             auto &sourceValue = _sourceValues[routeIndex];
+            bool updated = false;
             switch (midiSource.event()) {
             case Routing::MidiSource::Event::ControlAbsolute:
                 if (message.controlNumber() == midiSource.controlNumber()) {
                     sourceValue = message.controlValue() * (1.f / 127.f);
-                    consumed = true;
+                    updated = true;
                 }
                 break;
             case Routing::MidiSource::Event::ControlRelative:
@@ -40,45 +54,55 @@ bool RoutingEngine::receiveMidi(MidiPort port, const MidiMessage &message) {
                     int value = message.controlValue();
                     value = value >= 64 ? 64 - value : value;
                     sourceValue = clamp(sourceValue + value * (1.f / 127.f), 0.f, 1.f);
-                    consumed = true;
+                    updated = true;
                 }
                 break;
             case Routing::MidiSource::Event::PitchBend:
                 if (message.isPitchBend()) {
                     sourceValue = (message.pitchBend() + 0x2000) * (1.f / 16383.f);
-                    consumed = true;
+                    updated = true;
                 }
                 break;
             case Routing::MidiSource::Event::NoteMomentary:
                 if (message.isNoteOn() && message.note() == midiSource.note()) {
                     sourceValue = 1.f;
-                    consumed = true;
+                    updated = true;
                 } else if (message.isNoteOff() && message.note() == midiSource.note()) {
                     sourceValue = 0.f;
-                    consumed = true;
+                    updated = true;
                 }
                 break;
             case Routing::MidiSource::Event::NoteToggle:
                 if (message.isNoteOn() && message.note() == midiSource.note()) {
                     sourceValue = sourceValue < 0.5f ? 1.f : 0.f;
-                    consumed = true;
+                    updated = true;
                 }
                 break;
             case Routing::MidiSource::Event::NoteVelocity:
                 if (message.isNoteOn() && message.note() == midiSource.note()) {
                     sourceValue = message.velocity() * (1.f / 127.f);
-                    consumed = true;
+                    updated = true;
                 }
                 break;
             case Routing::MidiSource::Event::NoteRange:
                 if (message.isNoteOn() && message.note() >= midiSource.note() && message.note() < midiSource.note() + midiSource.noteRange()) {
                     sourceValue = (message.note() - midiSource.note()) / float(midiSource.noteRange() - 1);
-                    consumed = true;
+                    updated = true;
                 }
                 break;
             case Routing::MidiSource::Event::Last:
                 break;
             }
+
+            if (updated) {
+                // count values that are overwritten before the routing update applied them
+                MidiRouteIndex::RouteMask routeBit = 1 << routeIndex;
+                if (_midiPending & routeBit) {
+                    ++_midiOverflow;
+                }
+                _midiPending |= routeBit;
+                consumed = true;
+            }
         }
     }
 
@@ -127,14 +151,60 @@ void RoutingEngine::updateSources() {
 }
 
 void RoutingEngine::updateSinks() {
+    if (_invalidated || routesChanged()) {
+        compileRoutes();
+    }
+
+    for (int i = 0; i < _compiledRouteCount; ++i) {
+        auto &compiledRoute = _compiledRoutes[i];
+        float value = compiledRoute.min + _sourceValues[compiledRoute.routeIndex] * compiledRoute.range;
+        if (compiledRoute.engineTarget) {
+            writeEngineTarget(compiledRoute.target, value);
+        } else {
+            // only write targets if the value has changed, but periodically refresh one route at a time
+            // to restore routed values overwritten by the model (i.e. when pasting sequences)
+            bool changed = std::abs(value - compiledRoute.lastValue) >= ChangeThreshold;
+            if (changed || i == _refreshIndex) {
+                _routing.writeTarget(compiledRoute.target, compiledRoute.tracks, value);
+                compiledRoute.lastValue = value;
+            }
+            if (changed) {
+                ++_revision;
+            }
+        }
+    }
+
+    if (++_refreshIndex >= _compiledRouteCount) {
+        _refreshIndex = 0;
+    }
+
+    _midiPending = 0;
+}
+
+bool RoutingEngine::routesChanged() const {
     for (int routeIndex = 0; routeIndex < CONFIG_ROUTE_COUNT; ++routeIndex) {
         const auto &route = _routing.route(routeIndex);
-        auto &routeState = _routeStates[routeIndex];
+        const auto &routeState = _routeStates[routeIndex];
+        if (route.target() != routeState.target ||
+            route.tracks() != routeState.tracks ||
+            route.min() != routeState.min ||
+            route.max() != routeState.max ||
+            route.source() != routeState.source ||
+            (route.source() == Routing::Source::Midi && !(route.midiSource() == routeState.midiSource))
+        ) {
+            return true;
+        }
+    }
+    return false;
+}
 
-        bool routeChanged = route.target() != routeState.target || route.tracks() != routeState.tracks;
+void RoutingEngine::compileRoutes() {
+    // disable previous routings
+    for (int routeIndex = 0; routeIndex < CONFIG_ROUTE_COUNT; ++routeIndex) {
+        const auto &route = _routing.route(routeIndex);
+        auto &routeState = _routeStates[routeIndex];
 
-        if (routeChanged) {
-            // disable previous routing
+        if (route.target() != routeState.target || route.tracks() != routeState.tracks) {
             Routing::setRouted(routeState.target, routeState.tracks, false);
             // reset last state for play/record toggle
             if (routeState.target == Routing::Target::PlayToggle) {
@@ -144,25 +214,46 @@ void RoutingEngine::updateSinks() {
                 _lastRecordToggleActive = false;
             }
         }
+    }
 
-        if (route.active()) {
-            auto target = route.target();
-            float value = route.min() + _sourceValues[routeIndex] * (route.max() - route.min());
-            if (Routing::isEngineTarget(target)) {
-                writeEngineTarget(target, value);
-            } else {
-                _routing.writeTarget(target, route.tracks(), value);
-            }
-        }
+    // enable new routings and build dispatch table and MIDI index
+    _compiledRouteCount = 0;
+    _midiRouteIndex.clear();
+    for (int routeIndex = 0; routeIndex < CONFIG_ROUTE_COUNT; ++routeIndex) {
+        const auto &route = _routing.route(routeIndex);
+        auto &routeState = _routeStates[routeIndex];
 
-        if (routeChanged) {
-            // enable new routing
+        if (route.target() != routeState.target || route.tracks() != routeState.tracks) {
             Routing::setRouted(route.target(), route.tracks(), true);
-            // save state
-            routeState.target = route.target();
-            routeState.tracks = route.tracks();
+        }
+
+        routeState.target = route.target();
+        routeState.tracks = route.tracks();
+        routeState.min = route.min();
+        routeState.max = route.max();
+        routeState.source = route.source();
+        routeState.midiSource = route.midiSource();
+
+        if (route.active()) {
+            auto &compiledRoute = _compiledRoutes[_compiledRouteCount++];
+            compiledRoute.target = route.target();
+            compiledRoute.tracks = route.tracks();
+            compiledRoute.routeIndex = routeIndex;
+            compiledRoute.engineTarget = Routing::isEngineTarget(route.target());
+            compiledRoute.min = route.min();
+            compiledRoute.range = route.max() - route.min();
+            // force initial write
+            compiledRoute.lastValue = -1.f;
+
+            if (route.source() == Routing::Source::Midi) {
+                _midiRouteIndex.add(routeIndex, route.midiSource());
+            }
         }
     }
+
+    _refreshIndex = 0;
+    _invalidated = false;
+    ++_revision;
 }
 
 void RoutingEngine::writeEngineTarget(Routing::Target target, float normalized) {
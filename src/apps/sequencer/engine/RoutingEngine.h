@@ -3,6 +3,7 @@
 #include "Config.h"
 
 #include "MidiPort.h"
+#include "MidiRouteIndex.h"
 
 #include "model/Model.h"
 
@@ -22,10 +23,22 @@ public:
 
     bool receiveMidi(MidiPort port, const MidiMessage &message);
 
+    // force rewriting all route targets on next update
+    void invalidate() { _invalidated = true; }
+
+    // number of MIDI route values overwritten before being applied
+    uint32_t midiOverflow() const { return _midiOverflow; }
+
+    // incremented whenever routed values written to the model (i.e. sequence parameters) changed
+    uint32_t revision() const { return _revision; }
+
 private:
     void updateSources();
     void updateSinks();
 
+    bool routesChanged() const;
+    void compileRoutes();
+
     void writeEngineTarget(Routing::Target target, float normalized);
 
     Engine &_engine;
@@ -36,10 +49,35 @@ private:
     struct RouteState {
         Routing::Target target = Routing::Target::None;
         uint8_t tracks = 0;
+        float min = 0.f;
+        float max = 0.f;
+        Routing::Source source = Routing::Source::None;
+        Routing::MidiSource midiSource;
     };
 
     std::array<RouteState, CONFIG_ROUTE_COUNT> _routeStates;
 
+    // flat dispatch table of active routes, rebuilt when the routing changes
+    struct CompiledRoute {
+        Routing::Target target;
+        uint8_t tracks;
+        uint8_t routeIndex;
+        bool engineTarget;
+        float min;
+        float range;
+        float lastValue;
+    };
+
+    std::array<CompiledRoute, CONFIG_ROUTE_COUNT> _compiledRoutes;
+    int _compiledRouteCount = 0;
+    int _refreshIndex = 0;
+    bool _invalidated = true;
+
+    MidiRouteIndex _midiRouteIndex;
+    MidiRouteIndex::RouteMask _midiPending = 0;
+    uint32_t _midiOverflow = 0;
+    uint32_t _revision = 0;
+
     uint8_t _lastPlayToggleActive = false;
     uint8_t _lastRecordToggleActive = false;
 };
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+
+#include <cstddef>
+#include <cstdint>
+
+// Keeps the times (in microseconds) at which the most recent clock ticks were generated.
+template<size_t Count>
+class TickTimes {
+public:
+    TickTimes() {
+        clear();
+    }
+
+    void clear() {
+        _times.fill(0);
+    }
+
+    void record(uint32_t tick, uint32_t time) {
+        _times[tick % Count] = time;
+    }
+
+    // returns the time of the given tick, where nextTick is the tick generated next.
+    // If the tick is not in the history anymore (the sequencer fell more than Count ticks behind)
+    // or was not generated yet, fallback is returned.
+    uint32_t time(uint32_t tick, uint32_t nextTick, uint32_t fallback) const {
+        uint32_t age = nextTick - tick;
+        return age >= 1 && age <= Count ? _times[tick % Count] : fallback;
+    }
+
+private:
+    std::array<uint32_t, Count> _times;
+};
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <array>
+
+#include <cstddef>
+#include <cstdint>
+
+// Fixed capacity queue of events scheduled at engine ticks (T needs a uint32_t tick member).
+// Events are hashed into slots by their tick, each slot keeps a tick ordered list with a tail
+// pointer, so events scheduled in order (the common case) are appended without walking the list.
+// A bit mask of occupied slots is used to find the next event without visiting empty slots.
+// Events further away than the wheel span share slots with nearer events and are kept in
+// order within their slot. Events with equal ticks are returned in insertion order.
+// When full, new events are dropped and counted as overflow, pending events are never lost.
+template<typename T, size_t Capacity, size_t Slots = 32>
+class TimingWheel {
+public:
+    static_assert(Capacity < 255, "capacity too large");
+    static_assert(Slots == 32, "slot mask needs 32 slots");
+
+    TimingWheel() {
+        clear();
+    }
+
+    void clear() {
+        _head.fill(Nil);
+        _tail.fill(Nil);
+        _occupied = 0;
+        for (size_t i = 0; i < Capacity; ++i) {
+            _next[i] = i + 1 < Capacity ? i + 1 : Nil;
+        }
+        _free = 0;
+        _front = Nil;
+        _last = 0;
+        _size = 0;
+    }
+
+    size_t capacity() const { return Capacity; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    bool full() const { return _size == Capacity; }
+
+    // number of events dropped because the queue was full
+    uint32_t overflow() const { return _overflow; }
+
+    // maximum number of events queued at once
+    size_t peak() const { return _peak; }
+
+    void resetStats() {
+        _overflow = 0;
+        _peak = _size;
+    }
+
+    // inserts an event, returns false if the event was dropped
+    bool push(const T &value) {
+        if (_free == Nil) {
+            ++_overflow;
+            return false;
+        }
+
+        uint8_t node = _free;
+        _free = _next[node];
+        _events[node] = value;
+
+        // insert after all events at the same or an earlier tick
+        size_t slot = value.tick & SlotMask;
+        uint8_t tail = _tail[slot];
+        if (tail == Nil || _events[tail].tick <= value.tick) {
+            _next[node] = Nil;
+            if (tail == Nil) {
+                _head[slot] = node;
+            } else {
+                _next[tail] = node;
+            }
+            _tail[slot] = node;
+        } else {
+            // the tail is scheduled later, so the walk ends before it
+            uint8_t *link = &_head[slot];
+            while (_events[*link].tick <= value.tick) {
+                link = &_next[*link];
+            }
+            _next[node] = *link;
+            *link = node;
+        }
+        _occupied |= 1u << slot;
+
+        if (_front == Nil || value.tick < _events[_front].tick) {
+            _front = node;
+        }
+        if (_size == 0 || value.tick > _last) {
+            _last = value.tick;
+        }
+
+        ++_size;
+        _peak = _size > _peak ? _size : _peak;
+
+        return true;
+    }
+
+    // inserts an event and removes all events scheduled after it
+    bool pushReplace(const T &value) {
+        // events are mostly scheduled in order, nothing to remove in that case
+        if (_size > 0 && value.tick < _last) {
+            removeAfter(value.tick);
+        }
+        return push(value);
+    }
+
+    const T &front() const { return _events[_front]; }
+
+    void pop() {
+        if (_size == 0) {
+            return;
+        }
+
+        // the front event is always the head of its slot
+        uint32_t tick = _events[_front].tick;
+        size_t slot = tick & SlotMask;
+        uint8_t next = _next[_front];
+        release(_front);
+        _head[slot] = next;
+        if (next == Nil) {
+            _tail[slot] = Nil;
+            _occupied &= ~(1u << slot);
+        } else if (_events[next].tick == tick) {
+            // next event is scheduled at the same tick
+            _front = next;
+            return;
+        }
+        _front = findFront(tick);
+    }
+
+private:
+    static constexpr uint8_t Nil = 0xff;
+    static constexpr uint32_t SlotMask = Slots - 1;
+
+    // mask of the slots of ticks in [first, last], last - first < Slots
+    static uint32_t rangeMask(uint32_t first, uint32_t last) {
+        uint32_t count = last - first + 1;
+        uint32_t mask = count >= Slots ? 0xffffffff : (1u << count) - 1;
+        uint32_t offset = first & SlotMask;
+        return offset == 0 ? mask : (mask << offset) | (mask >> (Slots - offset));
+    }
+
+    // removes all events scheduled after the given tick
+    void removeAfter(uint32_t tick) {
+        uint32_t occupied = _occupied;
+        if (_last - tick < Slots) {
+            // only slots of the ticks up to the last event can hold later events
+            occupied &= rangeMask(tick + 1, _last);
+        }
+        _last = tick;
+        while (occupied) {
+            size_t slot = __builtin_ctz(occupied);
+            occupied &= occupied - 1;
+
+            // slots are ordered, nothing to remove if the tail is not scheduled later
+            if (_events[_tail[slot]].tick <= tick) {
+                continue;
+            }
+
+            uint8_t prev = Nil;
+            uint8_t *link = &_head[slot];
+            while (_events[*link].tick <= tick) {
+                prev = *link;
+                link = &_next[*link];
+            }
+            uint8_t node = *link;
+            *link = Nil;
+            while (node != Nil) {
+                uint8_t next = _next[node];
+                release(node);
+                node = next;
+            }
+            _tail[slot] = prev;
+            if (prev == Nil) {
+                _occupied &= ~(1u << slot);
+            }
+        }
+
+        if (_size == 0) {
+            _front = Nil;
+        }
+    }
+
+    void release(uint8_t node) {
+        _next[node] = _free;
+        _free = node;
+        --_size;
+    }
+
+    // find the earliest event, all remaining events are scheduled at or after the given tick
+    uint8_t findFront(uint32_t tick) const {
+        if (_occupied == 0) {
+            return Nil;
+        }
+
+        // visit occupied slots in tick order starting at the given tick,
+        // the first slot with an event within the wheel span holds the earliest event
+        size_t offset = tick & SlotMask;
+        uint32_t occupied = offset == 0 ? _occupied : (_occupied >> offset) | (_occupied << (Slots - offset));
+        uint8_t earliest = Nil;
+        while (occupied) {
+            size_t slot = (offset + __builtin_ctz(occupied)) & SlotMask;
+            occupied &= occupied - 1;
+
+            uint8_t node = _head[slot];
+            if (_events[node].tick - tick < Slots) {
+                return node;
+            }
+            if (earliest == Nil || _events[node].tick < _events[earliest].tick) {
+                earliest = node;
+            }
+        }
+
+        return earliest;
+    }
+
+    std::array<T, Capacity> _events;
+    std::array<uint8_t, Capacity> _next;
+    std::array<uint8_t, Slots> _head;
+    std::array<uint8_t, Slots> _tail;
+    uint32_t _occupied;
+    uint8_t _free;
+    uint8_t _front;
+    uint32_t _last;     // upper bound of queued ticks
+    size_t _size;
+    size_t _peak = 0;
+    uint32_t _overflow = 0;
+};
@@ -80,6 +80,16 @@ public:
 
     virtual const TrackLinkData *linkData() const { return nullptr; }
 
+    // tick scheduling
+
+    // Returns the next tick at which tick() needs to be called. The engine skips
+    // ticking the track engine on all ticks before. Track engines that are linked
+    // by other tracks need to be ticked on every tick to keep their link data valid.
+    uint32_t nextTick() const { return _linkSource ? 0 : _nextTick; }
+
+    bool linkSource() const { return _linkSource; }
+    void setLinkSource(bool linkSource) { _linkSource = linkSource; }
+
     // track output
 
     virtual bool activity() const = 0;
@@ -88,6 +98,9 @@ public:
 
     virtual float sequenceProgress() const { return -1.f; }
 
+    // number of gate/cv events dropped due to full event queues
+    virtual uint32_t queueOverflow() const { return 0; }
+
     // helpers
 
     bool isSelected() const { return _model.project().selectedTrackIndex() == _track.trackIndex(); }
@@ -105,6 +118,8 @@ protected:
     Track &_track;
     const PlayState::TrackState &_trackState;
     const TrackEngine *_linkedTrackEngine;
+    uint32_t _nextTick = 0;
+    bool _linkSource = false;
 };
 
 ENUM_CLASS_OPERATORS(TrackEngine::TickResult)
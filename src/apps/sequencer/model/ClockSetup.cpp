@@ -6,6 +6,7 @@ void ClockSetup::clear() {
     _shiftMode = ShiftMode::Restart;
     _clockInputDivisor = 12;
     _clockInputMode = ClockInputMode::Reset;
+    _pllBandwidth = PllBandwidth::Medium;
     _clockOutputDivisor = 12;
     _clockOutputSwing = false;
     _clockOutputPulse = 1;
@@ -30,6 +31,7 @@ void ClockSetup::write(VersionedSerializedWriter &writer) const {
     writer.write(_midiTx);
     writer.write(_usbRx);
     writer.write(_usbTx);
+    writer.write(_pllBandwidth);
 }
 
 void ClockSetup::read(VersionedSerializedReader &reader) {
@@ -45,4 +47,10 @@ void ClockSetup::read(VersionedSerializedReader &reader) {
     reader.read(_midiTx);
     reader.read(_usbRx);
     reader.read(_usbTx);
+    reader.read(_pllBandwidth, ProjectVersion::Version33);
+
+    // keep following slave clocks directly in projects created before the pll was added
+    if (reader.dataVersion() < ProjectVersion::Version33) {
+        _pllBandwidth = PllBandwidth::Off;
+    }
 }
@@ -63,6 +63,25 @@ public:
         return nullptr;
     }
 
+    enum class PllBandwidth : uint8_t {
+        Off = 0,
+        Low,
+        Medium,
+        High,
+        Last
+    };
+
+    static const char *pllBandwidthName(PllBandwidth bandwidth) {
+        switch (bandwidth) {
+        case PllBandwidth::Off:     return "Off";
+        case PllBandwidth::Low:     return "Low";
+        case PllBandwidth::Medium:  return "Medium";
+        case PllBandwidth::High:    return "High";
+        case PllBandwidth::Last:    break;
+        }
+        return nullptr;
+    }
+
     enum class ClockOutputMode : uint8_t {
         Reset = 0,
         Run,
@@ -154,6 +173,25 @@ public:
         str(clockInputModeName(clockInputMode()));
     }
 
+    // pllBandwidth
+
+    PllBandwidth pllBandwidth() const { return _pllBandwidth; }
+    void setPllBandwidth(PllBandwidth bandwidth) {
+        bandwidth = ModelUtils::clampedEnum(bandwidth);
+        if (bandwidth != _pllBandwidth) {
+            _pllBandwidth = bandwidth;
+            _dirty = true;
+        }
+    }
+
+    void editPllBandwidth(int value, int shift) {
+        setPllBandwidth(ModelUtils::adjustedEnum(pllBandwidth(), value));
+    }
+
+    void printPllBandwidth(StringBuilder &str) const {
+        str(pllBandwidthName(pllBandwidth()));
+    }
+
     // clockOutputDivisor
 
     int clockOutputDivisor() const { return _clockOutputDivisor; }
@@ -318,6 +356,7 @@ private:
     ShiftMode _shiftMode;
     uint8_t _clockInputDivisor;
     ClockInputMode _clockInputMode;
+    PllBandwidth _pllBandwidth;
     uint8_t _clockOutputDivisor;
     bool _clockOutputSwing;
     uint8_t _clockOutputPulse;
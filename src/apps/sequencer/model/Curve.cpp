@@ -141,4 +141,62 @@ Curve::Function Curve::function(Type type) {
 
 float Curve::eval(Type type, float x) {
     return functions[type](x);
+}
+
+// Lookup tables
+
+template<Curve::Function F>
+struct LookupTable {
+    LookupTable() {
+        for (int i = 0; i <= Curve::LookupSize; ++i) {
+            values[i] = F(float(i) / Curve::LookupSize);
+        }
+    }
+
+    float operator()(float x) const {
+        float pos = x * Curve::LookupSize;
+        int index = std::min(int(pos), Curve::LookupSize - 1);
+        float t = pos - index;
+        return values[index] + t * (values[index + 1] - values[index]);
+    }
+
+    float values[Curve::LookupSize + 1];
+};
+
+static const LookupTable<bell> bellTable;
+
+static inline float fract(float x) {
+    return x - int(x);
+}
+
+float Curve::evalLookup(Type type, float x) {
+    switch (type) {
+    case Low:               return 0.f;
+    case High:              return 1.f;
+    case RampUp:            return rampUp(x);
+    case RampDown:          return rampDown(x);
+    case ExpUp:             return expUp(x);
+    case ExpDown:           return expDown(x);
+    case LogUp:             return logUp(x);
+    case LogDown:           return logDown(x);
+    case SmoothUp:          return smoothUp(x);
+    case SmoothDown:        return smoothDown(x);
+    case RampUpHalf:        return x < 0.5f ? rampUp(x * 2.f) : 0.f;
+    case RampDownHalf:      return x < 0.5f ? rampDown(x * 2.f) : 0.f;
+    case ExpUpHalf:         return x < 0.5f ? expUp(x * 2.f) : 0.f;
+    case ExpDownHalf:       return x < 0.5f ? expDown(x * 2.f) : 0.f;
+    case LogUpHalf:         return x < 0.5f ? logUp(x * 2.f) : 0.f;
+    case LogDownHalf:       return x < 0.5f ? logDown(x * 2.f) : 0.f;
+    case SmoothUpHalf:      return x < 0.5f ? smoothUp(x * 2.f) : 0.f;
+    case SmoothDownHalf:    return x < 0.5f ? smoothDown(x * 2.f) : 0.f;
+    case Triangle:          return triangle(x);
+    case Bell:              return bellTable(x);
+    case StepUp:            return stepUp(x);
+    case StepDown:          return stepDown(x);
+    case ExpDown2x:         return x < 1.f ? expDown(fract(x * 2.f)) : 0.f;
+    case ExpDown3x:         return x < 1.f ? expDown(fract(x * 3.f)) : 0.f;
+    case ExpDown4x:         return x < 1.f ? expDown(fract(x * 4.f)) : 0.f;
+    case Last:              break;
+    }
+    return 0.f;
 }
\ No newline at end of file
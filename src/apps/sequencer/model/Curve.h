@@ -36,4 +36,11 @@ public:
     static Function function(Type type);
 
     static float eval(Type type, float x);
+
+    // Fast evaluation for the engine. Shapes built on transcendental functions
+    // are read from precomputed tables using linear interpolation, all other
+    // shapes are evaluated inline without library calls. Expects x in [0, 1].
+    static float evalLookup(Type type, float x);
+
+    static constexpr int LookupSize = 256;
 };
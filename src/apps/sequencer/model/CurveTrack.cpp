@@ -38,7 +38,7 @@ void CurveTrack::clear() {
     }
 }
 
-void CurveTrack::write(VersionedSerializedWriter &writer) const {
+void CurveTrack::writeProperties(VersionedSerializedWriter &writer) const {
     writer.write(_playMode);
     writer.write(_fillMode);
     writer.write(_muteMode);
@@ -47,10 +47,9 @@ void CurveTrack::write(VersionedSerializedWriter &writer) const {
     writer.write(_rotate.base);
     writer.write(_shapeProbabilityBias.base);
     writer.write(_gateProbabilityBias.base);
-    writeArray(writer, _sequences);
 }
 
-void CurveTrack::read(VersionedSerializedReader &reader) {
+void CurveTrack::readProperties(VersionedSerializedReader &reader) {
     reader.read(_playMode);
     reader.read(_fillMode);
     reader.read(_muteMode, ProjectVersion::Version22);
@@ -59,5 +58,4 @@ void CurveTrack::read(VersionedSerializedReader &reader) {
     reader.read(_rotate.base);
     reader.read(_shapeProbabilityBias.base, ProjectVersion::Version15);
     reader.read(_gateProbabilityBias.base, ProjectVersion::Version15);
-    readArray(reader, _sequences);
 }
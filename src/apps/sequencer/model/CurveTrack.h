@@ -218,8 +218,9 @@ public:
 
     void clear();
 
-    void write(VersionedSerializedWriter &writer) const;
-    void read(VersionedSerializedReader &reader);
+    // sequences are serialized by Track
+    void writeProperties(VersionedSerializedWriter &writer) const;
+    void readProperties(VersionedSerializedReader &reader);
 
 private:
     void setTrackIndex(int trackIndex) {
@@ -1,5 +1,7 @@
 #include "FileManager.h"
+#include "Model.h"
 #include "ProjectVersion.h"
+#include "ProjectChunks.h"
 
 #include "core/utils/StringBuilder.h"
 #include "core/fs/FileSystem.h"
@@ -9,6 +11,7 @@
 #include "os/os.h"
 
 #include <algorithm>
+#include <bitset>
 
 #include <cstring>
 
@@ -21,6 +24,7 @@ uint32_t FileManager::_cachedSlotInfoTicket = 0;
 FileManager::TaskExecuteCallback FileManager::_taskExecuteCallback;
 FileManager::TaskResultCallback FileManager::_taskResultCallback;
 volatile uint32_t FileManager::_taskPending;
+volatile float FileManager::_taskProgress = -1.f;
 
 struct FileTypeInfo {
     const char *dir;
@@ -32,6 +36,104 @@ FileTypeInfo fileTypeInfos[] = {
     { "SCALES", "SCA" },
 };
 
+// directory of the project file last written or read (kept off the file task stack)
+static ProjectChunks::Directory projectDirectory;
+// set if projectDirectory matches the last file written or read
+static bool projectDirectoryValid = false;
+// slot of the project file described by projectDirectory (-1 if unknown)
+static int projectDirectorySlot = -1;
+
+// chunks not yet read from the project file in deferredSlot
+static std::bitset<Project::ChunkCount> deferredChunks;
+static int deferredSlot = -1;
+
+// sink serializing into a fixed size buffer
+class StagingWriter {
+public:
+    StagingWriter(uint8_t *data, size_t capacity) :
+        _data(data),
+        _capacity(capacity)
+    {}
+
+    void write(const void *data, size_t len) {
+        if (_size + len <= _capacity) {
+            std::memcpy(_data + _size, data, len);
+        }
+        _size += len;
+    }
+
+    size_t size() const { return _size; }
+    bool overflow() const { return _size > _capacity; }
+
+private:
+    uint8_t *_data;
+    size_t _capacity;
+    size_t _size = 0;
+};
+
+// source reading from a fixed size buffer
+class StagingReader {
+public:
+    StagingReader(const uint8_t *data, size_t size) :
+        _data(data),
+        _size(size)
+    {}
+
+    void read(void *data, size_t len) {
+        size_t available = std::min(len, _size - _pos);
+        std::memcpy(data, _data + _pos, available);
+        std::memset(static_cast<uint8_t *>(data) + available, 0, len - available);
+        _pos += available;
+    }
+
+private:
+    const uint8_t *_data;
+    size_t _size;
+    size_t _pos = 0;
+};
+
+// project chunks being saved in the background
+static struct {
+    int slot;
+    FileHeader header;
+    bool inPlace;
+    std::bitset<Project::ChunkCount> pending;   // chunks not yet written
+    std::bitset<Project::ChunkCount> staged;    // chunks in the staging buffer
+    uint8_t data[CONFIG_PROJECT_STAGING_BUFFER_SIZE];
+} staging;
+
+// Serializes pending chunks (in order) into the staging buffer until it is full and updates their directory entries.
+// Each chunk is serialized with task switching suspended, so it cannot be torn by the engine (e.g. recording) or
+// the ui. Interrupts stay enabled, interrupt handlers never modify the project.
+// Returns false if a chunk changed in size, which invalidates an in-place write.
+static bool stageChunks(const Project &project) {
+    bool sizesUnchanged = true;
+    size_t size = 0;
+    staging.staged.reset();
+    for (int index = 0; index < Project::ChunkCount; ++index) {
+        if (!staging.pending[index]) {
+            continue;
+        }
+        StagingWriter writer(staging.data + size, sizeof(staging.data) - size);
+        {
+            os::SchedulerLock lock;
+            ProjectChunks::writeChunk(project, index, writer);
+        }
+        if (writer.overflow()) {
+            break;
+        }
+        FnvHash hash;
+        hash(staging.data + size, writer.size());
+        auto &entry = projectDirectory.entries[index];
+        sizesUnchanged &= entry.size == writer.size();
+        entry.size = writer.size();
+        entry.hash = hash.result();
+        size += writer.size();
+        staging.staged.set(index);
+    }
+    return sizesUnchanged;
+}
+
 static void slotPath(StringBuilder &str, FileType type, int slot) {
     const auto &info = fileTypeInfos[int(type)];
     str("%s/%03d.%s", info.dir, slot + 1, info.ext);
@@ -58,41 +160,142 @@ fs::Error FileManager::format() {
     return fs::volume().format();
 }
 
-fs::Error FileManager::writeProject(Project &project, int slot) {
-    return writeFile(FileType::Project, slot, [&] (const char *path) {
-        auto result = writeProject(project, path);
+fs::Error FileManager::readProject(Project &project, int slot, bool deferSequences) {
+    return readFile(FileType::Project, slot, [&] (const char *path) {
+        auto result = readProject(project, path, deferSequences);
         if (result == fs::OK) {
             project.setSlot(slot);
+            // the directory only describes the project once all chunks are read
+            projectDirectorySlot = projectDirectoryValid && deferredChunks.none() ? slot : -1;
+            deferredSlot = slot;
             writeLastProject(slot);
         }
         return result;
     });
 }
 
-fs::Error FileManager::readProject(Project &project, int slot) {
-    return readFile(FileType::Project, slot, [&] (const char *path) {
-        auto result = readProject(project, path);
+void FileManager::stageProject(const Project &project, int slot) {
+    staging.slot = slot;
+    staging.header = FileHeader(FileType::Project, ProjectChunks::FileVersion, project.name());
+    staging.pending.reset();
+
+    // chunks can be rewritten in place if the slot was last written or read by us,
+    // no chunk changed in size and all changed chunks fit the staging buffer.
+    // Fingerprinting is done without locking, a chunk modified meanwhile is either staged or
+    // keeps its previous content, both of which are valid states of the project.
+    bool inPlace = projectDirectorySlot == slot;
+    if (inPlace) {
+        size_t size = 0;
+        for (int index = 0; index < Project::ChunkCount; ++index) {
+            ProjectChunks::Fingerprint fingerprint;
+            ProjectChunks::writeChunk(project, index, fingerprint);
+            const auto &entry = projectDirectory.entries[index];
+            if (entry.size != fingerprint.size()) {
+                inPlace = false;
+                break;
+            }
+            if (entry.hash != fingerprint.hash()) {
+                staging.pending.set(index);
+                size += entry.size;
+            }
+        }
+        inPlace &= size <= sizeof(staging.data);
+    }
+
+    staging.inPlace = inPlace;
+    if (!inPlace) {
+        staging.pending.set();
+    }
+
+    // the directory is updated while staging and only describes the slot again once written
+    projectDirectoryValid = false;
+    projectDirectorySlot = -1;
+
+    // fall back to rewriting the file if a chunk changed in size after fingerprinting
+    if (!stageChunks(project) && staging.inPlace) {
+        staging.inPlace = false;
+        staging.pending.set();
+        stageChunks(project);
+    }
+}
+
+fs::Error FileManager::writeStagedProject(Project &project) {
+    int slot = staging.slot;
+    return writeFile(FileType::Project, slot, [&] (const char *path) {
+        auto result = writeStagedProject(project, path);
         if (result == fs::OK) {
             project.setSlot(slot);
+            project.setAutoLoaded(false);
+            projectDirectorySlot = slot;
             writeLastProject(slot);
         }
         return result;
     });
 }
 
-fs::Error FileManager::readLastProject(Project &project) {
+fs::Error FileManager::readLastProject(Project &project, bool deferSequences) {
     int slot;
 
     auto result = readLastProject(slot);
 
     if (result == fs::OK && slot >= 0) {
-        result = readProject(project, slot);
+        result = readProject(project, slot, deferSequences);
         project.setAutoLoaded(true);
     }
 
     return result;
 }
 
+fs::Error FileManager::readDeferredProjectChunks(Project &project) {
+    if (deferredChunks.none()) {
+        return fs::OK;
+    }
+
+    int slot = deferredSlot;
+    return readFile(FileType::Project, slot, [&] (const char *path) {
+        fs::FileReader fileReader(path);
+        if (fileReader.error() != fs::OK) {
+            return fileReader.error();
+        }
+
+        bool success = true;
+        uint32_t offset = 0;
+        for (int index = 0; index < Project::ChunkCount; ++index) {
+            if (!deferredChunks[index]) {
+                continue;
+            }
+            const auto &entry = projectDirectory.entries[index];
+            if (entry.size > sizeof(staging.data)) {
+                deferredChunks.reset();
+                return fs::NOT_ENOUGH_CORE;
+            }
+            if (entry.offset != offset) {
+                fileReader.seek(entry.offset);
+            }
+            // read the chunk into the (otherwise unused) staging buffer first, the engine is playing
+            // and must never see a partially read chunk
+            fileReader.read(staging.data, entry.size);
+            StagingReader reader(staging.data, entry.size);
+            {
+                os::SchedulerLock lock;
+                success &= ProjectChunks::readChunk(project, index, reader);
+            }
+            offset = entry.offset + entry.size;
+        }
+        deferredChunks.reset();
+
+        auto error = fileReader.finish();
+        if (error == fs::OK && !success) {
+            error = fs::INVALID_CHECKSUM;
+        }
+
+        if (error == fs::OK && projectDirectoryValid) {
+            projectDirectorySlot = slot;
+        }
+        return error;
+    });
+}
+
 fs::Error FileManager::writeUserScale(const UserScale &userScale, int slot) {
     return writeFile(FileType::UserScale, slot, [&] (const char *path) {
         return writeUserScale(userScale, path);
@@ -105,26 +308,102 @@ fs::Error FileManager::readUserScale(UserScale &userScale, int slot) {
     });
 }
 
-fs::Error FileManager::writeProject(const Project &project, const char *path) {
-    fs::FileWriter fileWriter(path);
+fs::Error FileManager::writeStagedProject(const Project &project, const char *path) {
+    auto &directory = projectDirectory;
+
+    fs::FileWriter fileWriter(path, staging.inPlace ? fs::File::ReadWrite : fs::File::Write);
     if (fileWriter.error() != fs::OK) {
         return fileWriter.error();
     }
 
-    FileHeader header(FileType::Project, 0, project.name());
-    fileWriter.write(&header, sizeof(header));
+    // when rewriting the file, reserve space for header and directory, they are written once all chunk sizes are known
+    if (!staging.inPlace) {
+        fileWriter.write(&staging.header, sizeof(staging.header));
+        fileWriter.write(&directory, sizeof(directory));
+    }
 
-    VersionedSerializedWriter writer(
-        [&fileWriter] (const void *data, size_t len) { fileWriter.write(data, len); },
-        ProjectVersion::Latest
-    );
+    int total = staging.pending.count();
+    int written = 0;
+    uint32_t offset = ProjectChunks::Directory::dataOffset();
+
+    while (staging.pending.any() && fileWriter.error() == fs::OK) {
+        // the first batch is staged by stageProject(), following batches are staged from the live project
+        if (staging.staged.none()) {
+            stageChunks(project);
+            if (staging.staged.none()) {
+                // chunk does not fit the staging buffer
+                return fs::NOT_ENOUGH_CORE;
+            }
+        }
 
-    project.write(writer);
+        const uint8_t *data = staging.data;
+        for (int index = 0; index < Project::ChunkCount; ++index) {
+            if (!staging.staged[index]) {
+                continue;
+            }
+            auto &entry = directory.entries[index];
+            if (staging.inPlace) {
+                fileWriter.seek(entry.offset);
+            } else {
+                entry.offset = offset;
+                offset += entry.size;
+            }
+            fileWriter.write(data, entry.size);
+            data += entry.size;
+            staging.pending.reset(index);
+            _taskProgress = float(++written) / total;
+        }
+        staging.staged.reset();
+    }
 
-    return fileWriter.finish();
+    directory.count = Project::ChunkCount;
+    directory.reserved = 0;
+    directory.updateHash();
+
+    fileWriter.seek(0);
+    fileWriter.write(&staging.header, sizeof(staging.header));
+    fileWriter.write(&directory, sizeof(directory));
+
+    auto result = fileWriter.finish();
+    projectDirectoryValid = result == fs::OK;
+    return result;
 }
 
-fs::Error FileManager::readProject(Project &project, const char *path) {
+// Reads the chunks needed to start playing a project, the remaining sequences are marked as deferred.
+static bool readPlayableProjectChunks(Project &project, fs::FileReader &fileReader) {
+    auto &directory = projectDirectory;
+
+    project.clear();
+
+    fileReader.read(&directory, sizeof(directory));
+    if (!directory.valid()) {
+        return project.finishRead(false);
+    }
+
+    bool success = true;
+    deferredChunks.set();
+    auto readChunk = [&] (int index) {
+        fileReader.seek(directory.entries[index].offset);
+        success &= ProjectChunks::readChunk(project, index, fileReader);
+        deferredChunks.reset(index);
+    };
+
+    // global state holds the play state with the patterns to read
+    readChunk(0);
+    readChunk(Project::ChunkCount - 1);
+    for (int trackIndex = 0; trackIndex < CONFIG_TRACK_COUNT; ++trackIndex) {
+        readChunk(Project::trackChunkIndex(trackIndex));
+        readChunk(Project::sequenceChunkIndex(trackIndex, project.playState().trackState(trackIndex).pattern()));
+    }
+
+    if (!success) {
+        deferredChunks.reset();
+    }
+
+    return project.finishRead(success);
+}
+
+fs::Error FileManager::readProject(Project &project, const char *path, bool deferSequences) {
     fs::FileReader fileReader(path);
     if (fileReader.error() != fs::OK) {
         return fileReader.error();
@@ -133,18 +412,26 @@ fs::Error FileManager::readProject(Project &project, const char *path) {
     FileHeader header;
     fileReader.read(&header, sizeof(header));
 
-    VersionedSerializedReader reader(
-        [&fileReader] (void *data, size_t len) { fileReader.read(data, len); },
-        ProjectVersion::Latest
-    );
-
-    bool success = project.read(reader);
+    projectDirectoryValid = false;
+    deferredChunks.reset();
+
+    bool success;
+    bool chunked = header.version != ProjectChunks::MonolithicFileVersion;
+    if (!chunked) {
+        VersionedSerializedReader reader(fileReader, ProjectVersion::Latest);
+        success = project.read(reader);
+    } else if (deferSequences) {
+        success = readPlayableProjectChunks(project, fileReader);
+    } else {
+        success = ProjectChunks::readProject(project, projectDirectory, fileReader);
+    }
 
     auto error = fileReader.finish();
     if (error == fs::OK && !success) {
         error = fs::INVALID_CHECKSUM;
     }
 
+    projectDirectoryValid = error == fs::OK && chunked;
     return error;
 }
 
@@ -157,10 +444,7 @@ fs::Error FileManager::writeUserScale(const UserScale &userScale, const char *pa
     FileHeader header(FileType::UserScale, 0, userScale.name());
     fileWriter.write(&header, sizeof(header));
 
-    VersionedSerializedWriter writer(
-        [&fileWriter] (const void *data, size_t len) { fileWriter.write(data, len); },
-        ProjectVersion::Latest
-    );
+    VersionedSerializedWriter writer(fileWriter, ProjectVersion::Latest);
 
     userScale.write(writer);
 
@@ -176,10 +460,7 @@ fs::Error FileManager::readUserScale(UserScale &userScale, const char *path) {
     FileHeader header;
     fileReader.read(&header, sizeof(header));
 
-    VersionedSerializedReader reader(
-        [&fileReader] (void *data, size_t len) { fileReader.read(data, len); },
-        ProjectVersion::Latest
-    );
+    VersionedSerializedReader reader(fileReader, ProjectVersion::Latest);
 
     bool success = userScale.read(reader);
 
@@ -200,10 +481,7 @@ fs::Error FileManager::writeSettings(const Settings &settings, const char *path)
     FileHeader header(FileType::Settings, 0, "SETTINGS");
     fileWriter.write(&header, sizeof(header));
 
-    VersionedSerializedWriter writer(
-        [&fileWriter] (const void *data, size_t len) { fileWriter.write(data, len); },
-        Settings::Version
-    );
+    VersionedSerializedWriter writer(fileWriter, Settings::Version);
 
     settings.write(writer);
 
@@ -219,10 +497,7 @@ fs::Error FileManager::readSettings(Settings &settings, const char *path) {
     FileHeader header;
     fileReader.read(&header, sizeof(header));
 
-    VersionedSerializedReader reader(
-        [&fileReader] (void *data, size_t len) { fileReader.read(data, len); },
-        Settings::Version
-    );
+    VersionedSerializedReader reader(fileReader, Settings::Version);
 
     bool success = settings.read(reader);
 
@@ -266,9 +541,14 @@ bool FileManager::slotUsed(FileType type, int slot) {
 void FileManager::task(TaskExecuteCallback executeCallback, TaskResultCallback resultCallback) {
     _taskExecuteCallback = executeCallback;
     _taskResultCallback = resultCallback;
+    _taskProgress = -1.f;
     _taskPending = 1;
 }
 
+float FileManager::taskProgress() {
+    return _taskPending ? _taskProgress : -1.f;
+}
+
 void FileManager::processTask() {
     // check volume availability & mount
     uint32_t ticks = os::ticks();
@@ -381,6 +661,7 @@ void FileManager::invalidateAllSlots() {
     for (auto &cachedSlotInfo : _cachedSlotInfos) {
         cachedSlotInfo.ticket = 0;
     }
+    projectDirectorySlot = -1;
 }
 
 uint32_t FileManager::nextCachedSlotTicket() {
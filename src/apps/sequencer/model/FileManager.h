@@ -21,15 +21,30 @@ public:
 
     static fs::Error format();
 
-    static fs::Error writeProject(Project &project, int slot);
-    static fs::Error readProject(Project &project, int slot);
-    static fs::Error readLastProject(Project &project);
+    static fs::Error readProject(Project &project, int slot, bool deferSequences = false);
+    static fs::Error readLastProject(Project &project, bool deferSequences = false);
+
+    // Reading a project with deferSequences set only reads what is needed to start playing (project settings,
+    // tracks, global state and the sequences of the playing patterns). The remaining sequences are read by
+    // readDeferredProjectChunks(), which can run while the engine is playing. Each chunk is applied with
+    // task switching suspended. Pattern changes must be held back (Engine::holdPlayState()) until all sequences are
+    // read. No other project file operation must be started in between.
+    static fs::Error readDeferredProjectChunks(Project &project);
+
+    // Saves a project without suspending the engine. stageProject() serializes the chunks that need to be
+    // written into a staging buffer, writeStagedProject() writes them from the file task. Chunks that do not
+    // fit the staging buffer are staged in batches while writing. Each chunk is serialized with
+    // task switching suspended and is consistent in itself, but the engine may modify the project in between chunks,
+    // so a chunk staged later can contain data recorded after the save was started. The ui must not change
+    // the project structure (e.g. track modes) until writeStagedProject() has completed.
+    static void stageProject(const Project &project, int slot);
+    static fs::Error writeStagedProject(Project &project);
 
     static fs::Error writeUserScale(const UserScale &userScale, int slot);
     static fs::Error readUserScale(UserScale &userScale, int slot);
 
-    static fs::Error writeProject(const Project &project, const char *path);
-    static fs::Error readProject(Project &project, const char *path);
+    static fs::Error writeStagedProject(const Project &project, const char *path);
+    static fs::Error readProject(Project &project, const char *path, bool deferSequences = false);
 
     static fs::Error writeUserScale(const UserScale &userScale, const char *path);
     static fs::Error readUserScale(UserScale &userScale, const char *path);
@@ -55,6 +70,9 @@ public:
     static void task(TaskExecuteCallback executeCallback, TaskResultCallback resultCallback);
     static void processTask();
 
+    // progress of the current task (0..1), negative if unknown
+    static float taskProgress();
+
 private:
     static fs::Error writeFile(FileType type, int slot, std::function<fs::Error(const char *)> write);
     static fs::Error readFile(FileType type, int slot, std::function<fs::Error(const char *)> read);
@@ -93,4 +111,5 @@ private:
     static TaskExecuteCallback _taskExecuteCallback;
     static TaskResultCallback _taskResultCallback;
     static volatile uint32_t _taskPending;
+    static volatile float _taskProgress;
 };
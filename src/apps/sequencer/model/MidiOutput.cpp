@@ -25,6 +25,7 @@ void MidiOutput::Output::write(VersionedSerializedWriter &writer) const {
     case MidiOutput::Output::Event::ControlChange:
         writer.write(_data.controlChange.controlNumber);
         writer.write(_data.controlChange.controlSource);
+        writer.write(_data.controlChange.controlDelta);
         break;
     case MidiOutput::Output::Event::Last:
         break;
@@ -46,6 +47,8 @@ void MidiOutput::Output::read(VersionedSerializedReader &reader) {
     case MidiOutput::Output::Event::ControlChange:
         reader.read(_data.controlChange.controlNumber);
         reader.read(_data.controlChange.controlSource);
+        _data.controlChange.controlDelta = 1;
+        reader.read(_data.controlChange.controlDelta, ProjectVersion::Version34);
         break;
     case MidiOutput::Output::Event::Last:
         break;
@@ -91,6 +91,7 @@ public:
                     _data.note.velocitySource = VelocitySource(int(VelocitySource::FirstVelocity) + 100);
                     break;
                 case Event::ControlChange:
+                    _data.controlChange.controlDelta = 1;
                     break;
                 case Event::Last:
                     break;
@@ -186,6 +187,21 @@ public:
             }
         }
 
+        // controlDelta
+
+        int controlDelta() const { return _data.controlChange.controlDelta; }
+        void setControlDelta(int controlDelta) {
+            _data.controlChange.controlDelta = clamp(controlDelta, 1, 16);
+        }
+
+        void editControlDelta(int value, bool shift) {
+            setControlDelta(controlDelta() + value);
+        }
+
+        void printControlDelta(StringBuilder &str) const {
+            str("%d", controlDelta());
+        }
+
         bool isNoteEvent() const {
             return event() == MidiOutput::Output::Event::Note;
         }
@@ -245,8 +261,9 @@ public:
             struct ControlChange {
                 uint8_t controlNumber;
                 ControlSource controlSource;
+                uint8_t controlDelta;
                 bool operator==(const ControlChange &other) const {
-                    return controlNumber == other.controlNumber && controlSource == other.controlSource;
+                    return controlNumber == other.controlNumber && controlSource == other.controlSource && controlDelta == other.controlDelta;
                 }
             } controlChange;
         } _data;
@@ -289,7 +289,9 @@ void NoteSequence::write(VersionedSerializedWriter &writer) const {
     writer.write(_firstStep.base);
     writer.write(_lastStep.base);
 
-    writeArray(writer, _steps);
+    // steps are serialized as their raw data words (see Step::write)
+    static_assert(sizeof(Step) == 2 * sizeof(uint32_t), "step must serialize without padding");
+    writeArrayBlock(writer, _steps);
 }
 
 void NoteSequence::read(VersionedSerializedReader &reader) {
@@ -305,5 +307,9 @@ void NoteSequence::read(VersionedSerializedReader &reader) {
     reader.read(_firstStep.base);
     reader.read(_lastStep.base);
 
-    readArray(reader, _steps);
+    if (reader.dataVersion() < ProjectVersion::Version27) {
+        readArray(reader, _steps);
+    } else {
+        readArrayBlock(reader, _steps);
+    }
 }
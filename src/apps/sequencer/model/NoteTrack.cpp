@@ -51,7 +51,7 @@ void NoteTrack::clear() {
     }
 }
 
-void NoteTrack::write(VersionedSerializedWriter &writer) const {
+void NoteTrack::writeProperties(VersionedSerializedWriter &writer) const {
     writer.write(_playMode);
     writer.write(_fillMode);
     writer.write(_fillMuted);
@@ -64,10 +64,9 @@ void NoteTrack::write(VersionedSerializedWriter &writer) const {
     writer.write(_retriggerProbabilityBias.base);
     writer.write(_lengthBias.base);
     writer.write(_noteProbabilityBias.base);
-    writeArray(writer, _sequences);
 }
 
-void NoteTrack::read(VersionedSerializedReader &reader) {
+void NoteTrack::readProperties(VersionedSerializedReader &reader) {
     reader.backupHash();
 
     reader.read(_playMode);
@@ -88,6 +87,4 @@ void NoteTrack::read(VersionedSerializedReader &reader) {
     if (reader.dataVersion() < ProjectVersion::Version23) {
         reader.restoreHash();
     }
-
-    readArray(reader, _sequences);
 }
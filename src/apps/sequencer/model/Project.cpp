@@ -103,38 +103,9 @@ void Project::setTrackMode(int trackIndex, Track::TrackMode trackMode) {
 }
 
 void Project::write(VersionedSerializedWriter &writer) const {
-    writer.write(_name, NameLength + 1);
-    writer.write(_tempo.base);
-    writer.write(_swing.base);
-    _timeSignature.write(writer);
-    writer.write(_syncMeasure);
-    writer.write(_alwaysSyncPatterns);
-    writer.write(_scale);
-    writer.write(_rootNote);
-    writer.write(_monitorMode);
-    writer.write(_recordMode);
-    writer.write(_midiInputMode);
-    writer.write(_midiIntegrationMode);
-    writer.write(_midiProgramOffset);
-    _midiInputSource.write(writer);
-    writer.write(_cvGateInput);
-    writer.write(_curveCvInput);
-
-    _clockSetup.write(writer);
-
-    writeArray(writer, _tracks);
-    writeArray(writer, _cvOutputTracks);
-    writeArray(writer, _gateOutputTracks);
-
-    _song.write(writer);
-    _playState.write(writer);
-    _routing.write(writer);
-    _midiOutput.write(writer);
-
-    writeArray(writer, UserScale::userScales);
-
-    writer.write(_selectedTrackIndex);
-    writer.write(_selectedPatternIndex);
+    for (int index = 0; index < ChunkCount; ++index) {
+        writeChunk(writer, index);
+    }
 
     writer.writeHash();
 
@@ -144,50 +115,112 @@ void Project::write(VersionedSerializedWriter &writer) const {
 bool Project::read(VersionedSerializedReader &reader) {
     clear();
 
-    reader.read(_name, NameLength + 1, ProjectVersion::Version5);
-    reader.read(_tempo.base);
-    reader.read(_swing.base);
-    if (reader.dataVersion() >= ProjectVersion::Version18) {
-        _timeSignature.read(reader);
-    }
-    reader.read(_syncMeasure);
-    if (reader.dataVersion() >= ProjectVersion::Version32) {
-        reader.read(_alwaysSyncPatterns);
-    }
-    reader.read(_scale);
-    reader.read(_rootNote);
-    reader.read(_monitorMode, ProjectVersion::Version30);
-    reader.read(_recordMode);
-    if (reader.dataVersion() >= ProjectVersion::Version29) {
-        reader.read(_midiInputMode);
-        _midiInputSource.read(reader);
-    }
-    if (reader.dataVersion() >= ProjectVersion::Version32) {
-        reader.read(_midiIntegrationMode);
-        reader.read(_midiProgramOffset);
+    for (int index = 0; index < ChunkCount; ++index) {
+        readChunk(reader, index);
     }
-    reader.read(_cvGateInput, ProjectVersion::Version6);
-    reader.read(_curveCvInput, ProjectVersion::Version11);
 
-    _clockSetup.read(reader);
+    return finishRead(reader.checkHash());
+}
+
+void Project::writeChunk(VersionedSerializedWriter &writer, int index) const {
+    if (index == 0) {
+        writer.write(_name, NameLength + 1);
+        writer.write(_tempo.base);
+        writer.write(_swing.base);
+        _timeSignature.write(writer);
+        writer.write(_syncMeasure);
+        writer.write(_alwaysSyncPatterns);
+        writer.write(_scale);
+        writer.write(_rootNote);
+        writer.write(_monitorMode);
+        writer.write(_recordMode);
+        writer.write(_midiInputMode);
+        writer.write(_midiIntegrationMode);
+        writer.write(_midiProgramOffset);
+        _midiInputSource.write(writer);
+        writer.write(_cvGateInput);
+        writer.write(_curveCvInput);
+
+        _clockSetup.write(writer);
+    } else if (index < ChunkCount - 1) {
+        const auto &track = _tracks[(index - 1) / TrackChunkCount];
+        int trackChunk = (index - 1) % TrackChunkCount;
+        if (trackChunk == 0) {
+            track.writeProperties(writer);
+        } else {
+            track.writeSequence(writer, trackChunk - 1);
+        }
+    } else {
+        writeArray(writer, _cvOutputTracks);
+        writeArray(writer, _gateOutputTracks);
 
-    readArray(reader, _tracks);
-    readArray(reader, _cvOutputTracks);
-    readArray(reader, _gateOutputTracks);
+        _song.write(writer);
+        _playState.write(writer);
+        _routing.write(writer);
+        _midiOutput.write(writer);
 
-    _song.read(reader);
-    _playState.read(reader);
-    _routing.read(reader);
-    _midiOutput.read(reader);
+        writeArray(writer, UserScale::userScales);
 
-    if (reader.dataVersion() >= ProjectVersion::Version5) {
-        readArray(reader, UserScale::userScales);
+        writer.write(_selectedTrackIndex);
+        writer.write(_selectedPatternIndex);
     }
+}
+
+void Project::readChunk(VersionedSerializedReader &reader, int index) {
+    if (index == 0) {
+        reader.read(_name, NameLength + 1, ProjectVersion::Version5);
+        reader.read(_tempo.base);
+        reader.read(_swing.base);
+        if (reader.dataVersion() >= ProjectVersion::Version18) {
+            _timeSignature.read(reader);
+        }
+        reader.read(_syncMeasure);
+        if (reader.dataVersion() >= ProjectVersion::Version32) {
+            reader.read(_alwaysSyncPatterns);
+        }
+        reader.read(_scale);
+        reader.read(_rootNote);
+        reader.read(_monitorMode, ProjectVersion::Version30);
+        reader.read(_recordMode);
+        if (reader.dataVersion() >= ProjectVersion::Version29) {
+            reader.read(_midiInputMode);
+            _midiInputSource.read(reader);
+        }
+        if (reader.dataVersion() >= ProjectVersion::Version32) {
+            reader.read(_midiIntegrationMode);
+            reader.read(_midiProgramOffset);
+        }
+        reader.read(_cvGateInput, ProjectVersion::Version6);
+        reader.read(_curveCvInput, ProjectVersion::Version11);
+
+        _clockSetup.read(reader);
+    } else if (index < ChunkCount - 1) {
+        auto &track = _tracks[(index - 1) / TrackChunkCount];
+        int trackChunk = (index - 1) % TrackChunkCount;
+        if (trackChunk == 0) {
+            track.readProperties(reader);
+        } else {
+            track.readSequence(reader, trackChunk - 1);
+        }
+    } else {
+        readArray(reader, _cvOutputTracks);
+        readArray(reader, _gateOutputTracks);
+
+        _song.read(reader);
+        _playState.read(reader);
+        _routing.read(reader);
+        _midiOutput.read(reader);
 
-    reader.read(_selectedTrackIndex);
-    reader.read(_selectedPatternIndex);
+        if (reader.dataVersion() >= ProjectVersion::Version5) {
+            readArray(reader, UserScale::userScales);
+        }
+
+        reader.read(_selectedTrackIndex);
+        reader.read(_selectedPatternIndex);
+    }
+}
 
-    bool success = reader.checkHash();
+bool Project::finishRead(bool success) {
     if (success) {
         _observable.notify(ProjectRead);
     } else {
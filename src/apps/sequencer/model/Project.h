@@ -477,6 +477,20 @@ public:
     void write(VersionedSerializedWriter &writer) const;
     bool read(VersionedSerializedReader &reader);
 
+    // The project is serialized as a sequence of chunks: the project settings, the properties and
+    // sequences of each track and the remaining global state (outputs, song, play state, routing,
+    // midi output, user scales, selection). write() and read() serialize all chunks in order.
+    // Reading individual chunks requires clear() before the first and finishRead() after the last chunk.
+    static constexpr int TrackChunkCount = 1 + Track::SequenceCount;
+    static constexpr int ChunkCount = 1 + CONFIG_TRACK_COUNT * TrackChunkCount + 1;
+
+    static int trackChunkIndex(int trackIndex) { return 1 + trackIndex * TrackChunkCount; }
+    static int sequenceChunkIndex(int trackIndex, int patternIndex) { return trackChunkIndex(trackIndex) + 1 + patternIndex; }
+
+    void writeChunk(VersionedSerializedWriter &writer, int index) const;
+    void readChunk(VersionedSerializedReader &reader, int index);
+    bool finishRead(bool success);
+
 private:
     uint8_t _slot = uint8_t(-1);
     char _name[NameLength + 1];
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Project.h"
+#include "ProjectVersion.h"
+#include "FileDefs.h"
+
+#include "core/hash/FnvHash.h"
+#include "core/io/VersionedSerializedWriter.h"
+#include "core/io/VersionedSerializedReader.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Chunked project file format (FileHeader::version == ProjectChunks::FileVersion):
+//
+//   FileHeader | Directory | chunk 0 | chunk 1 | ... | chunk N-1
+//
+// Each chunk is a complete versioned serialization (data version, data, hash) of one project chunk
+// (see Project::writeChunk()), so chunks are validated and upgraded independently. Chunks are stored
+// in order without gaps, which allows saving a project by only rewriting the chunks that changed,
+// as long as none of the chunks changed in size. Changed chunks are detected by comparing the 32-bit FNV hash
+// of their serialization with the hash stored in the directory. A hash collision (a changed chunk of the same
+// size with the same hash, probability 2^-32 per changed chunk) skips writing that chunk and the edit is
+// silently lost. This is accepted in favour of not having to read back or keep a copy of the stored chunks.
+// Files with FileHeader::version == 0 store the project as a single serialization (Project::write()).
+namespace ProjectChunks {
+
+static constexpr uint8_t MonolithicFileVersion = 0;
+static constexpr uint8_t FileVersion = 1;
+
+struct Entry {
+    uint32_t offset;
+    uint32_t size;
+    uint32_t hash;
+} __attribute__((packed));
+
+struct Directory {
+    uint16_t count;
+    uint16_t reserved;
+    Entry entries[Project::ChunkCount];
+    uint32_t hash;
+
+    uint32_t computeHash() const {
+        FnvHash hash;
+        hash(this, offsetof(Directory, hash));
+        return hash.result();
+    }
+
+    void updateHash() {
+        hash = computeHash();
+    }
+
+    bool valid() const {
+        return count == Project::ChunkCount && hash == computeHash();
+    }
+
+    // offset of the first chunk in the file
+    static constexpr uint32_t dataOffset() {
+        return sizeof(FileHeader) + sizeof(Directory);
+    }
+
+    // assigns consecutive offsets to all chunks based on their sizes
+    void layout() {
+        uint32_t offset = dataOffset();
+        for (auto &entry : entries) {
+            entry.offset = offset;
+            offset += entry.size;
+        }
+    }
+} __attribute__((packed));
+
+// Sink computing the size and hash of serialized data without storing it.
+class Fingerprint {
+public:
+    void write(const void *data, size_t len) {
+        _hash(data, len);
+        _size += len;
+    }
+
+    uint32_t size() const { return _size; }
+    uint32_t hash() const { return _hash.result(); }
+
+private:
+    FnvHash _hash;
+    uint32_t _size = 0;
+};
+
+template<typename Sink>
+static void writeChunk(const Project &project, int index, Sink &sink) {
+    VersionedSerializedWriter writer(sink, ProjectVersion::Latest);
+    project.writeChunk(writer, index);
+    writer.writeHash();
+}
+
+template<typename Source>
+static bool readChunk(Project &project, int index, Source &source) {
+    VersionedSerializedReader reader(source, ProjectVersion::Latest);
+    project.readChunk(reader, index);
+    return reader.checkHash();
+}
+
+// Reads a chunked project from a source positioned right after the file header.
+template<typename Source>
+static bool readProject(Project &project, Directory &directory, Source &source) {
+    project.clear();
+
+    source.read(&directory, sizeof(directory));
+    bool success = directory.valid();
+
+    for (int index = 0; success && index < Project::ChunkCount; ++index) {
+        success &= readChunk(project, index, source);
+    }
+
+    return project.finishRead(success);
+}
+
+} // namespace ProjectChunks
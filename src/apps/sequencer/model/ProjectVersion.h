@@ -1,3 +1,5 @@
+#pragma once
+
 enum ProjectVersion {
     // added NoteTrack::cvUpdateMode
     Version4 = 4,
@@ -93,6 +95,12 @@ enum ProjectVersion {
     // added Project::midiIntegrationMode, Project::midiProgramOffset, Project::alwaysSync
     Version32 = 32,
 
+    // added ClockSetup::pllBandwidth
+    Version33 = 33,
+
+    // added MidiOutput::Output::controlDelta
+    Version34 = 34,
+
     // automatically derive latest version
     Last,
     Latest = Last - 1,
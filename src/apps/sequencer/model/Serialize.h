@@ -4,6 +4,7 @@
 #include "core/io/VersionedSerializedReader.h"
 
 #include <array>
+#include <type_traits>
 
 #include <cstdlib>
 #include <cstdint>
@@ -17,9 +18,15 @@ static void writeArray(VersionedSerializedWriter &writer, const std::array<T, N>
 
 template<size_t N>
 static void writeArray(VersionedSerializedWriter &writer, const std::array<uint8_t, N> &array) {
-    for (size_t i = 0; i < array.size(); ++i) {
-        writer.write(array[i]);
-    }
+    writer.write(array.data(), array.size());
+}
+
+// Writes an array in a single block. Only valid for element types that serialize their memory
+// representation as is, i.e. all members are written in declaration order and there is no padding.
+template<typename T, size_t N>
+static void writeArrayBlock(VersionedSerializedWriter &writer, const std::array<T, N> &array) {
+    static_assert(std::is_trivially_copyable<T>::value, "block serialization requires trivially copyable type");
+    writer.write(array.data(), sizeof(T) * array.size());
 }
 
 template<typename T, size_t N>
@@ -31,7 +38,12 @@ static void readArray(VersionedSerializedReader &reader, std::array<T, N> &array
 
 template<size_t N>
 static void readArray(VersionedSerializedReader &reader, std::array<uint8_t, N> &array, size_t size = N) {
-    for (size_t i = 0; i < size; ++i) {
-        reader.read(array[i]);
-    }
+    reader.read(array.data(), size, 0);
+}
+
+// Reads an array written with writeArrayBlock().
+template<typename T, size_t N>
+static void readArrayBlock(VersionedSerializedReader &reader, std::array<T, N> &array, size_t size = N) {
+    static_assert(std::is_trivially_copyable<T>::value, "block serialization requires trivially copyable type");
+    reader.read(array.data(), sizeof(T) * size, 0);
 }
@@ -37,10 +37,7 @@ bool Settings::read(VersionedSerializedReader &reader) {
 void Settings::writeToFlash() const {
     FlashWriter flashWriter(CONFIG_SETTINGS_FLASH_ADDR, CONFIG_SETTINGS_FLASH_SECTOR);
 
-    VersionedSerializedWriter writer(
-        [&flashWriter] (const void *data, size_t len) { flashWriter.write(data, len); },
-        Version
-    );
+    VersionedSerializedWriter writer(flashWriter, Version);
 
     write(writer);
 
@@ -50,10 +47,7 @@ void Settings::writeToFlash() const {
 bool Settings::readFromFlash() {
     FlashReader flashReader(CONFIG_SETTINGS_FLASH_ADDR);
 
-    VersionedSerializedReader reader(
-        [&flashReader] (void *data, size_t len) { flashReader.read(data, len); },
-        Version
-    );
+    VersionedSerializedReader reader(flashReader, Version);
 
     return read(reader);
 }
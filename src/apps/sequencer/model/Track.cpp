@@ -75,15 +75,29 @@ void Track::cvOutputName(int index, StringBuilder &str) const {
 }
 
 void Track::write(VersionedSerializedWriter &writer) const {
+    writeProperties(writer);
+    for (int i = 0; i < SequenceCount; ++i) {
+        writeSequence(writer, i);
+    }
+}
+
+void Track::read(VersionedSerializedReader &reader) {
+    readProperties(reader);
+    for (int i = 0; i < SequenceCount; ++i) {
+        readSequence(reader, i);
+    }
+}
+
+void Track::writeProperties(VersionedSerializedWriter &writer) const {
     writer.writeEnum(_trackMode, trackModeSerialize);
     writer.write(_linkTrack);
 
     switch (_trackMode) {
     case TrackMode::Note:
-        _track.note->write(writer);
+        _track.note->writeProperties(writer);
         break;
     case TrackMode::Curve:
-        _track.curve->write(writer);
+        _track.curve->writeProperties(writer);
         break;
     case TrackMode::MidiCv:
         _track.midiCv->write(writer);
@@ -93,7 +107,7 @@ void Track::write(VersionedSerializedWriter &writer) const {
     }
 }
 
-void Track::read(VersionedSerializedReader &reader) {
+void Track::readProperties(VersionedSerializedReader &reader) {
     reader.readEnum(_trackMode, trackModeSerialize);
     reader.read(_linkTrack);
 
@@ -101,10 +115,10 @@ void Track::read(VersionedSerializedReader &reader) {
 
     switch (_trackMode) {
     case TrackMode::Note:
-        _track.note->read(reader);
+        _track.note->readProperties(reader);
         break;
     case TrackMode::Curve:
-        _track.curve->read(reader);
+        _track.curve->readProperties(reader);
         break;
     case TrackMode::MidiCv:
         _track.midiCv->read(reader);
@@ -114,6 +128,34 @@ void Track::read(VersionedSerializedReader &reader) {
     }
 }
 
+void Track::writeSequence(VersionedSerializedWriter &writer, int index) const {
+    switch (_trackMode) {
+    case TrackMode::Note:
+        _track.note->sequence(index).write(writer);
+        break;
+    case TrackMode::Curve:
+        _track.curve->sequence(index).write(writer);
+        break;
+    case TrackMode::MidiCv:
+    case TrackMode::Last:
+        break;
+    }
+}
+
+void Track::readSequence(VersionedSerializedReader &reader, int index) {
+    switch (_trackMode) {
+    case TrackMode::Note:
+        _track.note->sequence(index).read(reader);
+        break;
+    case TrackMode::Curve:
+        _track.curve->sequence(index).read(reader);
+        break;
+    case TrackMode::MidiCv:
+    case TrackMode::Last:
+        break;
+    }
+}
+
 void Track::initContainer() {
     _track.note = nullptr;
     _track.curve = nullptr;
@@ -128,6 +128,17 @@ public:
     void write(VersionedSerializedWriter &writer) const;
     void read(VersionedSerializedReader &reader);
 
+    // Track mode, link track and track properties are serialized separately from the sequences
+    // to allow storing them in individual chunks. write() is equal to writeProperties() followed
+    // by writeSequence() for all sequences.
+    static constexpr int SequenceCount = CONFIG_PATTERN_COUNT + CONFIG_SNAPSHOT_COUNT;
+
+    void writeProperties(VersionedSerializedWriter &writer) const;
+    void readProperties(VersionedSerializedReader &reader);
+
+    void writeSequence(VersionedSerializedWriter &writer, int index) const;
+    void readSequence(VersionedSerializedReader &reader, int index);
+
     Track &operator=(const Track &other) {
         ASSERT(_trackMode == other._trackMode, "invalid track mode");
         _linkTrack = other._linkTrack;
@@ -2,6 +2,7 @@
 #include "ProjectVersion.h"
 
 UserScale::Array UserScale::userScales;
+uint32_t UserScale::_revision;
 
 UserScale::UserScale() :
     Scale("")
@@ -9,6 +10,15 @@ UserScale::UserScale() :
     clear();
 }
 
+UserScale &UserScale::operator=(const UserScale &other) {
+    StringUtils::copy(_name, other._name, sizeof(_name));
+    _mode = other._mode;
+    _size = other._size;
+    _items = other._items;
+    ++_revision;
+    return *this;
+}
+
 void UserScale::clear() {
     StringUtils::copy(_name, "INIT", sizeof(_name));
     setMode(Mode::Chromatic);
@@ -21,6 +31,7 @@ void UserScale::clearItems() {
     if (_mode == Mode::Voltage) {
         _items[1] = 1000;
     }
+    ++_revision;
 }
 
 void UserScale::write(VersionedSerializedWriter &writer) const {
@@ -46,6 +57,8 @@ bool UserScale::read(VersionedSerializedReader &reader) {
         reader.read(_items[i]);
     }
 
+    ++_revision;
+
     bool success = reader.checkHash();
     if (!success) {
         clear();
@@ -60,6 +60,7 @@ public:
         if (mode != _mode) {
             _mode = mode;
             clearItems();
+            ++_revision;
         }
     }
 
@@ -76,6 +77,7 @@ public:
     int size() const { return _size; }
     void setSize(int size) {
         _size = clamp(size, _mode == Mode::Chromatic ? 1 : 2, CONFIG_USER_SCALE_SIZE);
+        ++_revision;
     }
 
     void editSize(int value, bool shift) {
@@ -103,6 +105,7 @@ public:
         case Mode::Last:
             break;
         }
+        ++_revision;
     }
 
     void editItem(int index, int value, int shift) {
@@ -137,6 +140,9 @@ public:
 
     UserScale();
 
+    UserScale(const UserScale &other) = default;
+    UserScale &operator=(const UserScale &other);
+
     void clear();
     void clearItems();
 
@@ -197,6 +203,9 @@ public:
 
     static Array userScales;
 
+    // Revision is incremented whenever any of the user scales is changed (used for invalidating caches).
+    static uint32_t revision() { return _revision; }
+
 private:
     void noteNameChromaticMode(StringBuilder &str, int note, int rootNote, Format format) const {
         bool printNote = format == Short1 || format == Long;
@@ -285,4 +294,6 @@ private:
     Mode _mode;
     uint8_t _size;
     ItemArray _items;
+
+    static uint32_t _revision;
 };
@@ -1,6 +1,10 @@
 #include "core/midi/MidiMessage.h"
+#include "core/profiler/Profiler.h"
 
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <vector>
 
 namespace py = pybind11;
 using namespace py::literals;
@@ -19,5 +23,52 @@ void register_core(py::module &m) {
         .def_static("makeProgramChange", &MidiMessage::makeProgramChange, py::arg("channel"), py::arg("programNumber"))
         .def_static("makeChannelPressure", &MidiMessage::makeChannelPressure, py::arg("channel"), py::arg("pressure"))
         .def_static("makePitchBend", &MidiMessage::makePitchBend, py::arg("channel"), py::arg("pitchBend"))
+        .def_property_readonly("status", &MidiMessage::status)
+        .def_property_readonly("length", &MidiMessage::length)
+    ;
+
+#if CONFIG_ENABLE_PROFILER
+    // ------------------------------------------------------------------------
+    // Profiler
+    // ------------------------------------------------------------------------
+
+    py::class_<Profiler> profiler(m, "Profiler");
+    profiler
+        .def_static("intervals", [] () {
+            std::vector<const Profiler::Interval *> intervals;
+            for (int i = 0; i < Profiler::intervalCount(); ++i) {
+                intervals.emplace_back(&Profiler::interval(i));
+            }
+            return intervals;
+        }, py::return_value_policy::reference)
+        .def_static("counters", [] () {
+            std::vector<const Profiler::Counter *> counters;
+            for (int i = 0; i < Profiler::counterCount(); ++i) {
+                counters.emplace_back(&Profiler::counter(i));
+            }
+            return counters;
+        }, py::return_value_policy::reference)
+        .def_static("reset", &Profiler::reset)
+    ;
+
+    py::class_<Profiler::Interval> interval(profiler, "Interval");
+    interval
+        .def_readonly("desc", &Profiler::Interval::desc)
+        .def_readonly("index", &Profiler::Interval::index)
+        .def_readonly("last", &Profiler::Interval::last)
+        .def_property_readonly("min", [] (const Profiler::Interval &interval) { return interval.count > 0 ? interval.min : 0; })
+        .def_readonly("max", &Profiler::Interval::max)
+        .def_property_readonly("mean", &Profiler::Interval::mean)
+        .def_readonly("count", &Profiler::Interval::count)
+        .def_property_readonly("histogram", [] (const Profiler::Interval &interval) {
+            return std::vector<uint32_t>(interval.histogram, interval.histogram + Profiler::Interval::Buckets);
+        })
+    ;
+
+    py::class_<Profiler::Counter> counter(profiler, "Counter");
+    counter
+        .def_readonly("desc", &Profiler::Counter::desc)
+        .def_readonly("count", &Profiler::Counter::count)
     ;
+#endif // CONFIG_ENABLE_PROFILER
 }
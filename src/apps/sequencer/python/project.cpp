@@ -1,5 +1,6 @@
 #include "model/Project.h"
 #include "model/ProjectVersion.h"
+#include "model/ProjectChunks.h"
 
 #include <pybind11/pybind11.h>
 
@@ -16,16 +17,32 @@ static void loadProject(Project &project, const std::string &filename) {
         throw std::runtime_error("Cannot open file");
     }
 
-    FileHeader header;
-    ifs.read(reinterpret_cast<char *>(&header), sizeof(header));
+    struct Source {
+        std::ifstream &ifs;
 
-    VersionedSerializedReader reader(
-        [&ifs] (void *data, size_t len) { ifs.read(reinterpret_cast<char *>(data), len); },
-        ProjectVersion::Latest
-    );
+        void read(void *data, size_t len) {
+            ifs.read(reinterpret_cast<char *>(data), len);
+        }
+    } source { ifs };
+
+    FileHeader header;
+    source.read(&header, sizeof(header));
+
+    bool success;
+    if (header.version == ProjectChunks::MonolithicFileVersion) {
+        VersionedSerializedReader reader(source, ProjectVersion::Latest);
+        success = project.read(reader);
+    } else {
+        ProjectChunks::Directory directory;
+        success = ProjectChunks::readProject(project, directory, source);
+    }
 
-    if (!project.read(reader)) {
-        throw std::runtime_error("Failed to load project");
+    // a truncated file also fails the checksum, report the read error first
+    if (!ifs.good()) {
+        throw std::runtime_error("Failed to load project (unexpected end of file)");
+    }
+    if (!success) {
+        throw std::runtime_error("Failed to load project (checksum mismatch)");
     }
 }
 
@@ -207,6 +224,7 @@ void register_project(py::module &m) {
         .def_property("shiftMode", &ClockSetup::shiftMode, &ClockSetup::setShiftMode)
         .def_property("clockInputDivisor", &ClockSetup::clockInputDivisor, &ClockSetup::setClockInputDivisor)
         .def_property("clockInputMode", &ClockSetup::clockInputMode, &ClockSetup::setClockInputMode)
+        .def_property("pllBandwidth", &ClockSetup::pllBandwidth, &ClockSetup::setPllBandwidth)
         .def_property("clockOutputDivisor", &ClockSetup::clockOutputDivisor, &ClockSetup::setClockOutputDivisor)
         .def_property("clockOutputSwing", &ClockSetup::clockOutputSwing, &ClockSetup::setClockOutputSwing)
         .def_property("clockOutputPulse", &ClockSetup::clockOutputPulse, &ClockSetup::setClockOutputPulse)
@@ -238,6 +256,14 @@ void register_project(py::module &m) {
         .export_values()
     ;
 
+    py::enum_<ClockSetup::PllBandwidth>(clockSetup, "PllBandwidth")
+        .value("Off", ClockSetup::PllBandwidth::Off)
+        .value("Low", ClockSetup::PllBandwidth::Low)
+        .value("Medium", ClockSetup::PllBandwidth::Medium)
+        .value("High", ClockSetup::PllBandwidth::High)
+        .export_values()
+    ;
+
     py::enum_<ClockSetup::ClockOutputMode>(clockSetup, "ClockOutputMode")
         .value("Reset", ClockSetup::ClockOutputMode::Reset)
         .value("Run", ClockSetup::ClockOutputMode::Run)
@@ -672,6 +698,38 @@ void register_project(py::module &m) {
     // MidiOutput
     // ------------------------------------------------------------------------
 
+    py::class_<MidiOutput> midiOutput(m, "MidiOutput");
+    midiOutput
+        .def_property_readonly("outputs", [] (MidiOutput &midiOutput) {
+            py::list result;
+            for (int i = 0; i < CONFIG_MIDI_OUTPUT_COUNT; ++i) {
+                result.append(&midiOutput.output(i));
+            }
+            return result;
+        })
+        .def("clear", &MidiOutput::clear)
+    ;
+
+    py::class_<MidiOutput::Output> midiOutputOutput(midiOutput, "Output");
+    midiOutputOutput
+        .def_property_readonly("target", [] (MidiOutput::Output &output) { return &output.target(); })
+        .def_property("event", &MidiOutput::Output::event, [] (MidiOutput::Output &output, MidiOutput::Output::Event event) { output.setEvent(event); })
+        .def_property("controlNumber", &MidiOutput::Output::controlNumber, &MidiOutput::Output::setControlNumber)
+        .def_property("controlDelta", &MidiOutput::Output::controlDelta, &MidiOutput::Output::setControlDelta)
+        .def_property("controlTrack",
+            [] (MidiOutput::Output &output) { return int(output.controlSource()) - int(MidiOutput::Output::ControlSource::FirstTrack); },
+            [] (MidiOutput::Output &output, int trackIndex) { output.setControlSource(MidiOutput::Output::ControlSource(int(MidiOutput::Output::ControlSource::FirstTrack) + trackIndex)); }
+        )
+        .def("clear", &MidiOutput::Output::clear)
+    ;
+
+    py::enum_<MidiOutput::Output::Event>(midiOutputOutput, "Event")
+        .value("None", MidiOutput::Output::Event::None)
+        .value("Note", MidiOutput::Output::Event::Note)
+        .value("ControlChange", MidiOutput::Output::Event::ControlChange)
+        .export_values()
+    ;
+
     // ------------------------------------------------------------------------
     // TimeSignature
     // ------------------------------------------------------------------------
@@ -15,6 +15,23 @@ void register_sequencer(py::module &m) {
     py::class_<SequencerApp> sequencer(m, "Sequencer");
     sequencer
         .def_property_readonly("model", [] (SequencerApp &app) { return &app.model; })
+        .def_property_readonly("engine", [] (SequencerApp &app) { return &app.engine; })
+    ;
+
+    // ------------------------------------------------------------------------
+    // Engine
+    // ------------------------------------------------------------------------
+
+    py::class_<Engine> engine(m, "Engine");
+    engine
+        .def_property_readonly("stats", &Engine::stats)
+    ;
+
+    py::class_<Engine::Stats> stats(engine, "Stats");
+    stats
+        .def_readonly("outputOverflow", &Engine::Stats::outputOverflow)
+        .def_readonly("routingMidiOverflow", &Engine::Stats::routingMidiOverflow)
+        .def_readonly("trackQueueOverflow", &Engine::Stats::trackQueueOverflow)
     ;
 
     // ------------------------------------------------------------------------
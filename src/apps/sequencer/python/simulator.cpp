@@ -1,6 +1,8 @@
 #include "sim/Simulator.h"
+#include "sim/TargetEdgeRecorder.h"
 
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 namespace py = pybind11;
 
@@ -19,9 +21,38 @@ void register_simulator(py::module &m) {
         .def("rotateEncoder", &Simulator::rotateEncoder)
         .def("setAdc", &Simulator::setAdc)
         .def("setDio", &Simulator::setDio)
+        .def("scheduleDio", &Simulator::scheduleDio)
         .def("sendMidi", &Simulator::sendMidi)
         .def("screenshot", &Simulator::screenshot)
         .def_property_readonly("targetState", &Simulator::targetState, py::return_value_policy::reference)
+        .def_property_readonly("time", &Simulator::time)
+    ;
+
+    // ------------------------------------------------------------------------
+    // TargetEdgeRecorder
+    // ------------------------------------------------------------------------
+
+    py::class_<TargetEdgeRecorder> edgeRecorder(m, "TargetEdgeRecorder");
+    edgeRecorder
+        .def(py::init<Simulator &>(), py::keep_alive<1, 2>())
+        .def_property_readonly("gateOutput", &TargetEdgeRecorder::gateOutput)
+        .def_property_readonly("digitalOutput", &TargetEdgeRecorder::digitalOutput)
+        .def_property_readonly("midiOutput", &TargetEdgeRecorder::midiOutput)
+        .def("clear", &TargetEdgeRecorder::clear)
+    ;
+
+    py::class_<TargetEdgeRecorder::Edge> edge(edgeRecorder, "Edge");
+    edge
+        .def_readonly("time", &TargetEdgeRecorder::Edge::time)
+        .def_readonly("channel", &TargetEdgeRecorder::Edge::channel)
+        .def_readonly("value", &TargetEdgeRecorder::Edge::value)
+    ;
+
+    py::class_<TargetEdgeRecorder::Midi> midi(edgeRecorder, "Midi");
+    midi
+        .def_readonly("time", &TargetEdgeRecorder::Midi::time)
+        .def_readonly("port", &TargetEdgeRecorder::Midi::port)
+        .def_readonly("message", &TargetEdgeRecorder::Midi::message)
     ;
 
     // ------------------------------------------------------------------------
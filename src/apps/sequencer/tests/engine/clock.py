@@ -0,0 +1,70 @@
+import random
+
+import testframework as tf
+
+ClockSetup = tf.sequencer.ClockSetup
+
+class ClockFollowerTest(tf.UiTest):
+
+    def measureClockFollower(self, bandwidth, jitter, tempo=120, ppqn=24, seconds=20, settle=5):
+        p = self.env.sequencer.model.project
+        s = self.env.simulator
+
+        # follow clock input with the given ppqn, output clock at the same rate
+        p.clockSetup.mode = ClockSetup.Mode.Slave
+        p.clockSetup.clockInputMode = ClockSetup.ClockInputMode.Reset
+        p.clockSetup.clockInputDivisor = 48 // ppqn
+        p.clockSetup.clockOutputDivisor = 48 // ppqn
+        p.clockSetup.pllBandwidth = bandwidth
+        self.controller.wait(10)
+
+        # inject jittered clock pulses on the clock input
+        rng = random.Random(1234)
+        period = 60000.0 / (tempo * ppqn)
+        start = s.time + 10
+        pulses = int(seconds * 1000 / period)
+        for i in range(pulses):
+            time = start + i * period + rng.uniform(-jitter, jitter)
+            s.scheduleDio(time, 0, True)
+            s.scheduleDio(time + 1, 0, False)
+
+        recorder = tf.simulator.TargetEdgeRecorder(s)
+        self.controller.wait(int(seconds * 1000) + 100)
+
+        # output clock edges after the PLL settled, paired with the ideal (jitter free) input pulses
+        edges = [e.time for e in recorder.digitalOutput if e.channel == 0 and e.value]
+        self.assertGreater(len(edges), pulses * 0.9, "clock output")
+        first = int(settle * 1000 / period)
+        edges = edges[first:pulses - 1]
+        ideal = [start + (first + i) * period for i in range(len(edges))]
+
+        # jitter: deviation of output edges from their mean latency to the ideal grid
+        offsets = [edge - reference for edge, reference in zip(edges, ideal)]
+        latency = sum(offsets) / len(offsets)
+        deviations = [offset - latency for offset in offsets]
+        rmsJitter = (sum(d * d for d in deviations) / len(deviations)) ** 0.5
+        maxJitter = max(abs(d) for d in deviations)
+
+        # drift: change of latency between the first and last quarter of the measurement
+        quarter = len(offsets) // 4
+        drift = sum(offsets[-quarter:]) / quarter - sum(offsets[:quarter]) / quarter
+
+        print("bandwidth=%s jitter=%.2fms edges=%d latency=%.3fms rms jitter=%.3fms max jitter=%.3fms drift=%.3fms" % (
+            bandwidth, jitter, len(edges), latency, rmsJitter, maxJitter, drift))
+
+        return rmsJitter, maxJitter, drift
+
+    def test_clean_clock(self):
+        rms, peak, drift = self.measureClockFollower(ClockSetup.PllBandwidth.Medium, 0)
+        self.assertLess(peak, 0.2, "max jitter")
+        self.assertLess(abs(drift), 0.2, "drift")
+
+    def test_jittered_clock(self):
+        rmsOff, peakOff, driftOff = self.measureClockFollower(ClockSetup.PllBandwidth.Off, 2)
+        self.tearDown()
+        self.setUp()
+        rmsPll, peakPll, driftPll = self.measureClockFollower(ClockSetup.PllBandwidth.Medium, 2)
+
+        self.assertLess(rmsPll, rmsOff / 2, "rms jitter reduced by pll")
+        self.assertLess(peakPll, peakOff / 2, "max jitter reduced by pll")
+        self.assertLess(abs(driftPll), 0.5, "drift")
@@ -0,0 +1,63 @@
+import testframework as tf
+
+MidiOutput = tf.sequencer.MidiOutput
+Curve = tf.sequencer.Track.TrackMode.Curve
+
+class MidiClockTest(tf.UiTest):
+
+    def measureClockJitter(self, flood, seconds=5):
+        c = self.controller
+        p = self.env.sequencer.model.project
+        s = self.env.simulator
+
+        p.tempo = 120
+        p.clockSetup.midiTx = True
+        p.clockSetup.usbTx = False
+
+        if flood:
+            # all outputs send control changes from fast moving curves
+            for trackIndex in range(8):
+                p.setTrackMode(trackIndex, Curve)
+                sequence = p.tracks[trackIndex].curveTrack.sequences[0]
+                sequence.divisor = 1
+                for step in sequence.steps:
+                    step.shape = 4 + trackIndex % 2
+            for index, output in enumerate(p.midiOutput.outputs):
+                output.event = MidiOutput.Output.Event.ControlChange
+                output.target.port = tf.sequencer.Types.MidiPort.Midi
+                output.target.channel = index
+                output.controlTrack = index % 8
+                output.controlNumber = 1 + index // 8
+            c.wait(10)
+
+        recorder = tf.simulator.TargetEdgeRecorder(s)
+        c.press("play").wait(int(seconds * 1000)).press("play").wait(100)
+
+        midi = [m for m in recorder.midiOutput if m.port == 0]
+        ticks = [m.time for m in midi if m.message.status == 0xf8]
+        others = len(midi) - len(ticks)
+        self.assertGreater(len(ticks), seconds * 48 * 0.9, "clock messages")
+
+        # jitter: deviation of clock intervals from the nominal interval
+        period = 60000.0 / (p.tempo * 24)
+        intervals = [b - a for a, b in zip(ticks, ticks[1:])]
+        deviations = [interval - period for interval in intervals]
+        rmsJitter = (sum(d * d for d in deviations) / len(deviations)) ** 0.5
+        maxJitter = max(abs(d) for d in deviations)
+
+        print("flood=%s clock=%d other=%d rms jitter=%.3fms max jitter=%.3fms" % (
+            flood, len(ticks), others, rmsJitter, maxJitter))
+
+        return others, rmsJitter, maxJitter
+
+    def test_clock_jitter(self):
+        _, rmsIdle, maxIdle = self.measureClockJitter(False)
+        self.tearDown()
+        self.setUp()
+        others, rmsFlood, maxFlood = self.measureClockJitter(True)
+
+        # clock bytes are delayed by at most the message being transmitted (3 bytes at 320us)
+        self.assertGreater(others, 5 * 16 * 40, "control change flood")
+        self.assertLess(maxIdle, 0.5, "max jitter without load")
+        self.assertLess(maxFlood, 1.0, "max jitter under load")
+        self.assertLess(rmsFlood, 0.5, "rms jitter under load")
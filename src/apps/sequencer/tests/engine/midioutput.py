@@ -0,0 +1,53 @@
+import testframework as tf
+
+MidiOutput = tf.sequencer.MidiOutput
+MidiPort = tf.sequencer.Types.MidiPort
+Curve = tf.sequencer.Track.TrackMode.Curve
+
+class MidiOutputTest(tf.UiTest):
+
+    def measureControlChanges(self, port, seconds=2):
+        c = self.controller
+        p = self.env.sequencer.model.project
+        s = self.env.simulator
+
+        # all outputs send control changes from fast moving curves
+        p.tempo = 120
+        for trackIndex in range(8):
+            p.setTrackMode(trackIndex, Curve)
+            sequence = p.tracks[trackIndex].curveTrack.sequences[0]
+            sequence.divisor = 1
+            for step in sequence.steps:
+                step.shape = 4 + trackIndex % 2
+        for index, output in enumerate(p.midiOutput.outputs):
+            output.event = MidiOutput.Output.Event.ControlChange
+            output.target.port = port
+            output.target.channel = index
+            output.controlTrack = index % 8
+            output.controlNumber = 1 + index // 8
+        c.wait(10)
+
+        recorder = tf.simulator.TargetEdgeRecorder(s)
+        c.press("play").wait(int(seconds * 1000))
+        stopTime = s.time
+        c.press("play").wait(100)
+
+        messages = [m for m in recorder.midiOutput if m.port == int(port) and m.message.status & 0xf0 == 0xb0]
+        rate = len(messages) / seconds / 16
+        lag = messages[-1].time - stopTime if messages else 0
+
+        print("port=%s control changes=%d rate per output=%.1f/s lag=%.2fms" % (port, len(messages), rate, lag))
+
+        return rate, lag
+
+    def test_usb_control_rate(self):
+        rate, lag = self.measureControlChanges(MidiPort.UsbMidi)
+        # well above the previous fixed 50 Hz rate, limited by the curve tracks updating once per tick
+        self.assertGreater(rate, 200, "usb control change rate")
+
+    def test_din_control_rate(self):
+        rate, lag = self.measureControlChanges(MidiPort.Midi)
+        # bounded by the serial bandwidth, the output does not fall behind
+        self.assertLess(rate * 16 * 3, 3125, "din control change bandwidth")
+        self.assertGreater(rate, 40, "din control change rate")
+        self.assertLess(lag, 20, "din output lag")
@@ -0,0 +1,27 @@
+import unittest
+
+import testframework as tf
+
+# the profiler is only bound when built with CONFIG_ENABLE_PROFILER
+@unittest.skipUnless(hasattr(tf.core, "Profiler"), "profiler disabled")
+class ProfilerTest(tf.UiTest):
+
+    def test_intervals(self):
+        c = self.controller
+
+        tf.core.Profiler.reset()
+        c.press("play").wait(1000).press("play").wait(100)
+
+        intervals = { (i.desc, i.index) : i for i in tf.core.Profiler.intervals() }
+
+        engine = intervals[("ENGINE", -1)]
+        self.assertGreater(engine.count, 900, "engine update samples")
+        self.assertLessEqual(engine.min, engine.mean, "min <= mean")
+        self.assertLessEqual(engine.mean, engine.max, "mean <= max")
+        self.assertEqual(sum(engine.histogram), engine.count, "histogram samples")
+
+        for track in range(8):
+            self.assertGreater(intervals[("TRACK UPDATE", track)].count, 0, "track update samples")
+
+        for desc in ["ROUTING", "MIDI OUTPUT", "UI"]:
+            self.assertGreater(intervals[(desc, -1)].count, 0, desc + " samples")
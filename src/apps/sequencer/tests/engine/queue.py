@@ -0,0 +1,29 @@
+import testframework as tf
+
+class EventQueueTest(tf.UiTest):
+
+    def test_max_retrigger_stress(self):
+        c = self.controller
+        p = self.env.sequencer.model.project
+        engine = self.env.sequencer.engine
+
+        # maximum retriggers on every step of a 64 step pattern at the fastest divisor on all tracks,
+        # alternating gate offsets make the events of adjacent steps overlap
+        p.tempo = 300
+        for track in p.tracks:
+            sequence = track.noteTrack.sequences[0]
+            sequence.divisor = 1
+            sequence.firstStep = 0
+            sequence.lastStep = 63
+            for index, step in enumerate(sequence.steps):
+                step.gate = True
+                step.retrigger = 3
+                step.length = 7
+                step.gateOffset = 7 if index % 2 == 0 else 0
+
+        overflow = engine.stats.trackQueueOverflow
+        c.press("play").wait(4000).press("play").wait(100)
+
+        overflow = engine.stats.trackQueueOverflow - overflow
+        print("track queue overflow=%d" % overflow)
+        self.assertEqual(overflow, 0, "track queue overflow")
@@ -0,0 +1,41 @@
+import testframework as tf
+
+class GateTimingTest(tf.UiTest):
+
+    def measureGateJitter(self, tempo, divisor, retrigger):
+        c = self.controller
+        p = self.env.sequencer.model.project
+
+        p.tempo = tempo
+        sequence = p.tracks[0].noteTrack.sequences[0]
+        sequence.divisor = divisor
+        for step in sequence.steps:
+            step.gate = True
+            step.retrigger = retrigger
+
+        recorder = tf.simulator.TargetEdgeRecorder(self.env.simulator)
+        c.press("play").wait(4000).press("play").wait(100)
+
+        # ideal tick times are derived from the first clock output edge (tick 0)
+        period = int(60 * 1000000 / (tempo * 192)) / 1000.0
+        clockEdges = [e for e in recorder.digitalOutput if e.channel == 0 and e.value]
+        gateEdges = [e for e in recorder.gateOutput if e.channel == 0 and e.value]
+        self.assertTrue(len(clockEdges) > 0, "clock output")
+        self.assertTrue(len(gateEdges) > 100, "gate output")
+
+        start = clockEdges[0].time
+        phases = [(e.time - start) % period for e in gateEdges]
+
+        # gates are output with a constant latency, measure deviation from that
+        reference = phases[0]
+        errors = [abs((phase - reference + period / 2) % period - period / 2) for phase in phases]
+        maxError = max(errors)
+        meanError = sum(errors) / len(errors)
+        print("tempo=%d divisor=%d retrigger=%d edges=%d max error=%.3fms mean error=%.3fms" % (tempo, divisor, retrigger, len(gateEdges), maxError, meanError))
+        return maxError
+
+    def test_gate_timing(self):
+        self.assertLess(self.measureGateJitter(120, 12, 0), 0.01, "max error")
+
+    def test_ratchet_timing(self):
+        self.assertLess(self.measureGateJitter(250, 3, 2), 0.01, "max error")
@@ -0,0 +1,96 @@
+#include "DependencyTracker.h"
+
+#include <cmath>
+#include <cstring>
+
+DependencyTracker::DependencyTracker(const Model &model, const Engine &engine) :
+    _model(model),
+    _engine(engine)
+{
+    std::memset(&_state, 0, sizeof(_state));
+}
+
+Page::Dependency DependencyTracker::update() {
+    State state;
+    read(state);
+
+    Page::Dependency changed = Page::NoDependency;
+
+    if (!state.headerEquals(_state)) {
+        changed |= Page::SelectedTrackDependency;
+    }
+    if (!state.playPositionEquals(_state)) {
+        changed |= Page::PlayPositionDependency;
+    }
+    // recording writes step data from the engine, routing writes sequence parameters (i.e. first/last step)
+    if ((state.recording && state.running) || state.routingRevision != _state.routingRevision) {
+        changed |= Page::StepDataDependency;
+    }
+
+    _state = state;
+
+    return changed;
+}
+
+void DependencyTracker::read(State &state) const {
+    const auto &project = _model.project();
+    const auto &playState = project.playState();
+
+    state.selectedTrack = project.selectedTrackIndex();
+    state.selectedPattern = project.selectedPatternIndex();
+    state.playPattern = playState.trackState(state.selectedTrack).pattern();
+    state.snapshotActive = playState.snapshotActive();
+    state.songActive = playState.songState().playing();
+    state.recording = _engine.recording();
+    state.clockMode = uint8_t(_engine.clock().activeMode());
+    // tempo is displayed with one decimal
+    state.tempo = std::lround(_engine.tempo() * 10.f);
+
+    state.running = _engine.clockRunning();
+    state.currentStep = -1;
+    state.currentRecordStep = -1;
+
+    const auto &trackEngine = _engine.selectedTrackEngine();
+    switch (trackEngine.trackMode()) {
+    case Track::TrackMode::Note:
+        state.currentStep = trackEngine.as<NoteTrackEngine>().currentStep();
+        state.currentRecordStep = trackEngine.as<NoteTrackEngine>().currentRecordStep();
+        break;
+    case Track::TrackMode::Curve:
+        state.currentStep = trackEngine.as<CurveTrackEngine>().currentStep();
+        break;
+    default:
+        break;
+    }
+
+    uint32_t hash = 0;
+    for (const auto trackEngine : _engine.trackEngines()) {
+        float progress = trackEngine->sequenceProgress();
+        uint32_t bits;
+        std::memcpy(&bits, &progress, sizeof(bits));
+        hash = hash * 31 + bits;
+    }
+    state.progressHash = hash;
+
+    state.routingRevision = _engine.routingEngine().revision();
+}
+
+bool DependencyTracker::State::headerEquals(const State &other) const {
+    return
+        selectedTrack == other.selectedTrack &&
+        selectedPattern == other.selectedPattern &&
+        playPattern == other.playPattern &&
+        snapshotActive == other.snapshotActive &&
+        songActive == other.songActive &&
+        recording == other.recording &&
+        clockMode == other.clockMode &&
+        tempo == other.tempo;
+}
+
+bool DependencyTracker::State::playPositionEquals(const State &other) const {
+    return
+        running == other.running &&
+        currentStep == other.currentStep &&
+        currentRecordStep == other.currentRecordStep &&
+        progressHash == other.progressHash;
+}
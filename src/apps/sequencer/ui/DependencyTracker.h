@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Page.h"
+
+#include "engine/Engine.h"
+
+#include "model/Model.h"
+
+#include <cstdint>
+
+// Polls the model and engine state pages can depend on and reports which of it changed since the last update.
+// State changed by user input is not tracked, the UI invalidates all pages on input events instead.
+class DependencyTracker {
+public:
+    DependencyTracker(const Model &model, const Engine &engine);
+
+    // returns the dependencies that changed since the last call
+    Page::Dependency update();
+
+private:
+    struct State {
+        // header
+        int8_t selectedTrack;
+        int8_t selectedPattern;
+        int8_t playPattern;
+        bool snapshotActive;
+        bool songActive;
+        bool recording;
+        uint8_t clockMode;
+        int32_t tempo;
+        // play position
+        bool running;
+        int16_t currentStep;
+        int16_t currentRecordStep;
+        uint32_t progressHash;
+        // step data
+        uint32_t routingRevision;
+
+        bool headerEquals(const State &other) const;
+        bool playPositionEquals(const State &other) const;
+    };
+
+    void read(State &state) const;
+
+    const Model &_model;
+    const Engine &_engine;
+    State _state;
+};
@@ -12,13 +12,15 @@ public:
 
     void showMessage(const char *text, uint32_t duration = 1000);
 
-    void update();
+    // returns true if a message was shown or hidden since the last update
+    bool update();
 
     void draw(Canvas &canvas);
 
 private:
     char _text[64];
     uint32_t _timeout = 0;
+    bool _changed = false;
 
     os::Mutex _mutex;
 };
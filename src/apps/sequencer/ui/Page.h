@@ -6,11 +6,25 @@
 #include "Leds.h"
 
 #include "core/gfx/Canvas.h"
+#include "core/utils/EnumUtils.h"
 
 class PageManager;
 
 class Page {
 public:
+    // State a page depends on. Pages are only redrawn when one of their dependencies changed,
+    // when a draw was scheduled with PageManager::scheduleDraw() or, if they depend on
+    // animations, at the rate returned by fps(). Input events always trigger a redraw.
+    enum Dependency {
+        NoDependency            = 0,
+        SelectedTrackDependency = (1<<0),   // selected track/pattern and the clock state shown in the header
+        StepDataDependency      = (1<<1),   // sequence data that can change without user input (recording, routing)
+        PlayPositionDependency  = (1<<2),   // transport and current steps of the track engines
+        MessageDependency       = (1<<3),   // message overlay
+        AnimationDependency     = (1<<4),   // redraw on every frame
+        AllDependencies         = 0xff,
+    };
+
     Page(PageManager &manager);
 
     virtual void enter() {}
@@ -21,6 +35,8 @@ public:
 
     virtual int fps() const { return CONFIG_DEFAULT_UI_FPS; }
 
+    virtual Dependency dependencies() const { return AllDependencies; }
+
     virtual bool isModal() const { return false; }
 
     // Event handlers
@@ -42,3 +58,5 @@ protected:
 
     PageManager &_manager;
 };
+
+ENUM_CLASS_OPERATORS(Page::Dependency)
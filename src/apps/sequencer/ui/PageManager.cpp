@@ -15,6 +15,7 @@ void PageManager::push(Page *page) {
     ASSERT(_pageStackPos < PageStackSize - 1, "page stack overflow");
     _pageStack[++_pageStackPos] = page;
     page->enter();
+    invalidate();
 
     notifyPageSwitch(page);
 }
@@ -23,6 +24,7 @@ void PageManager::pop() {
     ASSERT(_pageStackPos > 0, "page stack underflow");
     top()->exit();
     --_pageStackPos;
+    invalidate();
 
     if (_pageStackPos >= 0) {
         notifyPageSwitch(top());
@@ -43,6 +45,7 @@ void PageManager::replace(int index, Page *page) {
     pagePtr->exit();
     pagePtr = page;
     pagePtr->enter();
+    invalidate();
 
     if (index == _pageStackPos) {
         notifyPageSwitch(page);
@@ -71,6 +74,35 @@ int PageManager::fps() const {
     return fps;
 }
 
+Page::Dependency PageManager::dependencies() const {
+    Page::Dependency dependencies = Page::NoDependency;
+    for (int i = 0; i <= _pageStackPos; ++i) {
+        dependencies |= _pageStack[i]->dependencies();
+    }
+    return dependencies;
+}
+
+void PageManager::scheduleDraw(uint32_t ticks) {
+    if (!_drawScheduled || int32_t(ticks - _drawScheduledTicks) < 0) {
+        _drawScheduledTicks = ticks;
+    }
+    _drawScheduled = true;
+}
+
+bool PageManager::needsDraw(uint32_t currentTicks) {
+    auto dependencies = this->dependencies();
+
+    // message overlay is drawn on top of all pages
+    bool draw = (dependencies & Page::AnimationDependency) || (_invalid & (dependencies | Page::MessageDependency));
+    _invalid = Page::NoDependency;
+
+    if (_drawScheduled && int32_t(currentTicks - _drawScheduledTicks) >= 0) {
+        _drawScheduled = false;
+        draw = true;
+    }
+
+    return draw;
+}
 
 void PageManager::dispatchEvent(Event &event) {
     // handle modal page
@@ -35,6 +35,19 @@ public:
 
     int fps() const;
 
+    // redraw scheduling
+
+    // combined dependencies of all pages on the stack
+    Page::Dependency dependencies() const;
+
+    void invalidate(Page::Dependency dependencies = Page::AllDependencies) { _invalid |= dependencies; }
+
+    // requests a redraw once the given tick count is reached (e.g. to hide a popup after a timeout)
+    void scheduleDraw(uint32_t ticks);
+
+    // returns true if the page stack needs to be redrawn and resets the invalidated state
+    bool needsDraw(uint32_t currentTicks);
+
     void dispatchEvent(Event &event);
 
     void setPageSwitchHandler(PageSwitchHandler pageSwitchHandler) {
@@ -52,5 +65,8 @@ private:
     static const int PageStackSize = 8;
     std::array<Page *, PageStackSize> _pageStack;
     int _pageStackPos = -1;
+    Page::Dependency _invalid = Page::AllDependencies;
+    bool _drawScheduled = false;
+    uint32_t _drawScheduledTicks;
     PageSwitchHandler _pageSwitchHandler;
 };
@@ -9,6 +9,9 @@
 
 #include "model/Model.h"
 
+PROFILER_INTERVAL(uiUpdate, "UI")
+PROFILER_COUNTER(uiSkippedDraws, "UI SKIP")
+
 Ui::Ui(Model &model, Engine &engine, Lcd &lcd, ButtonLedMatrix &blm, Encoder &encoder, Settings &settings) :
         _model(model),
         _engine(engine),
@@ -20,6 +23,7 @@ Ui::Ui(Model &model, Engine &engine, Lcd &lcd, ButtonLedMatrix &blm, Encoder &en
         _pageManager(_pages),
         _pageContext({ _messageManager, _pageKeyState, _globalKeyState, _model, _engine }),
         _pages(_pageManager, _pageContext),
+        _dependencyTracker(model, engine),
         _controllerManager(model, engine),
         // TODO pass as arg
         _screensaver(Screensaver(
@@ -46,11 +50,11 @@ void Ui::init() {
     _pageManager.push(&_pages.startup);
 
     _engine.setMidiReceiveHandler([this] (MidiPort port, uint8_t cable, const MidiMessage &message) {
-        if (!_receiveMidiEvents.writable()) {
+        if (_receiveMidiEvents.writable()) {
+            _receiveMidiEvents.write({ port, cable, message });
+        } else {
             DBG("ui midi buffer overflow");
-            _receiveMidiEvents.read();
         }
-        _receiveMidiEvents.write({ port, cable, message });
         return port == MidiPort::UsbMidi && _controllerManager.isConnected();
     });
 
@@ -73,6 +77,8 @@ void Ui::init() {
 }
 
 void Ui::update() {
+    PROFILER_INTERVAL_SCOPE(uiUpdate)
+
     handleKeys();
     handleEncoder();
     handleMidi();
@@ -86,19 +92,32 @@ void Ui::update() {
     _pageManager.updateLeds(_leds);
     _blm.setLeds(_leds.array());
 
-    // update display at target fps
+    // update display at target fps, pages are only redrawn if any state they depend on changed
     uint32_t currentTicks = os::ticks();
     uint32_t intervalTicks = os::time::ms(1000 / _pageManager.fps());
     if (currentTicks - _lastFrameBufferUpdateTicks >= intervalTicks) {
         _screensaver.incScreenOnTicks(intervalTicks);
+        _pageManager.invalidate(_dependencyTracker.update());
+        if (_messageManager.update()) {
+            _pageManager.invalidate(Page::MessageDependency);
+        }
         if (!_screensaver.shouldBeOn()) {
-            _pageManager.draw(_canvas);
-            _messageManager.update();
-            _messageManager.draw(_canvas);
+            if (_pageManager.needsDraw(currentTicks)) {
+                _pageManager.draw(_canvas);
+                _messageManager.draw(_canvas);
+            } else {
+                PROFILER_COUNTER_ADD(uiSkippedDraws, 1)
+            }
         } else {
             _screensaver.on(_engine.gateOutput());
+            // redraw pages after screensaver turns off
+            _pageManager.invalidate();
+        }
+        // only send rows that were drawn to, and rows of a dropped frame even if nothing was redrawn
+        if (_frameBuffer.isDirty() || _lcd.hasPending()) {
+            _lcd.draw(_frameBuffer.data(), _frameBuffer.dirtyTop(), _frameBuffer.dirtyBottom());
+            _frameBuffer.clearDirty();
         }
-        _lcd.draw(_frameBuffer.data());
         _lastFrameBufferUpdateTicks += intervalTicks;
     }
 
@@ -129,6 +148,7 @@ void Ui::showAssert(const char *filename, int line, const char *msg) {
 
     _canvas.drawText(4, 58, "PRESS ENCODER TO RESET");
 
+    _lcd.flush();
     _lcd.draw(_frameBuffer.data());
 }
 
@@ -139,6 +159,7 @@ void Ui::handleKeys() {
         _pageKeyState[event.value()] = isDown;
         _globalKeyState[event.value()] = isDown;
         Key key(event.value(), _globalKeyState);
+        _pageManager.invalidate();
 
         KeyEvent keyEvent(isDown ? Event::KeyDown : Event::KeyUp, key);
         _screensaver.consumeKey(keyEvent);
@@ -154,6 +175,7 @@ void Ui::handleKeys() {
 void Ui::handleEncoder() {
     Encoder::Event event;
     while (_encoder.nextEvent(event)) {
+        _pageManager.invalidate();
         switch (event) {
             case Encoder::Left:
             case Encoder::Right: {
@@ -185,6 +207,8 @@ void Ui::handleEncoder() {
 void Ui::handleMidi() {
     while (_receiveMidiEvents.readable()) {
         auto receiveEvent = _receiveMidiEvents.read();
+        // controllers and pages may change the model on midi input
+        _pageManager.invalidate();
         if (!_controllerManager.recvMidi(receiveEvent.port, receiveEvent.cable, receiveEvent.message)) {
             // only process events from cable 0
             if (receiveEvent.cable == 0) {
@@ -8,6 +8,7 @@
 #include "KeyPressEventTracker.h"
 #include "Leds.h"
 #include "ControllerManager.h"
+#include "DependencyTracker.h"
 
 #include "pages/Pages.h"
 
@@ -55,8 +56,8 @@ private:
     };
     RingBuffer<ReceiveMidiEvent, 16> _receiveMidiEvents;
 
-    uint8_t _frameBufferData[CONFIG_LCD_WIDTH * CONFIG_LCD_HEIGHT];
-    FrameBuffer8bit _frameBuffer;
+    uint32_t _frameBufferData[CONFIG_LCD_WIDTH * CONFIG_LCD_HEIGHT / FrameBuffer4bit::PixelsPerWord];
+    FrameBuffer4bit _frameBuffer;
     Canvas _canvas;
     uint32_t _lastFrameBufferUpdateTicks;
 
@@ -70,6 +71,7 @@ private:
     PageManager _pageManager;
     PageContext _pageContext;
     Pages _pages;
+    DependencyTracker _dependencyTracker;
 
     ControllerManager _controllerManager;
     uint32_t _lastControllerUpdateTicks;
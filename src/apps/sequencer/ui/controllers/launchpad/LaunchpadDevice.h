@@ -2,6 +2,7 @@
 
 #include "core/midi/MidiMessage.h"
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <functional>
@@ -77,6 +78,54 @@ public:
 protected:
     static constexpr uint8_t Cable = 0;
 
+    // "set LEDs" system exclusive command of a device
+    struct SysExLedCommand {
+        std::array<uint8_t, 6> header;  // manufacturer id, device id and command
+        bool lightingType;              // each led is prefixed by the lighting type (0 = static)
+    };
+
+    // Sends changed leds in bulk using the device's "set LEDs" system exclusive command,
+    // ledNumber(index) maps a led index to the device's led number. At most one message (one payload pool slot)
+    // is sent per call to leave the pool to other senders. Leds that do not fit the message or fail to send are
+    // left unsynced and sent with the next call, which continues after the last led sent.
+    template<typename LedNumber>
+    void syncLedsSysEx(uint8_t cable, const SysExLedCommand &command, LedNumber ledNumber) {
+        const size_t ledLength = command.lightingType ? 3 : 2;
+        const size_t maxLength = std::min(MidiMessage::maxPayloadLength(), sizeof(_sysExBuffer));
+
+        size_t length = command.header.size();
+        std::copy(command.header.begin(), command.header.end(), _sysExBuffer);
+
+        // continue scanning where the previous message ended, so leds with high indices cannot starve
+        int count = 0;
+        for (; count < ButtonCount && length + ledLength <= maxLength; ++count) {
+            int index = (_sysExLedIndex + count) % ButtonCount;
+            if (_deviceLedState[index] != _ledState[index]) {
+                if (command.lightingType) {
+                    _sysExBuffer[length++] = 0;
+                }
+                _sysExBuffer[length++] = ledNumber(index);
+                _sysExBuffer[length++] = _ledState[index];
+            }
+        }
+
+        if (length == command.header.size()) {
+            return;
+        }
+
+        // payload pool is exhausted or send queue is full
+        auto message = MidiMessage::makeSystemExclusive(_sysExBuffer, length);
+        if (!message.hasPayload() || !sendMidi(cable, message)) {
+            return;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int index = (_sysExLedIndex + i) % ButtonCount;
+            _deviceLedState[index] = _ledState[index];
+        }
+        _sysExLedIndex = (_sysExLedIndex + count) % ButtonCount;
+    }
+
     bool sendMidi(uint8_t cable, const MidiMessage &message) {
         if (_sendMidiHandler) {
             return _sendMidiHandler(cable, message);
@@ -96,4 +145,7 @@ protected:
     std::bitset<ButtonCount> _buttonState;
     std::array<uint8_t, ButtonCount> _ledState;
     std::array<uint8_t, ButtonCount> _deviceLedState;
+    uint8_t _sysExBuffer[128];
+    // led index syncLedsSysEx() continues with
+    int _sysExLedIndex = 0;
 };
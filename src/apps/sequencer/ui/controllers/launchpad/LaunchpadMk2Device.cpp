@@ -46,35 +46,17 @@ void LaunchpadMk2Device::recvMidi(uint8_t cable, const MidiMessage &message) {
 }
 
 void LaunchpadMk2Device::syncLeds() {
-    // grid
-    for (int row = 0; row < Rows; ++row) {
-        for (int col = 0; col < Cols; ++col) {
-            int index = row * Cols + col;
-            if (_deviceLedState[index] != _ledState[index]) {
-                if (sendMidi(Cable, MidiMessage::makeNoteOn(0, 11 + 10 * (7 - row) + col, _ledState[index]))) {
-                    _deviceLedState[index] = _ledState[index];
-                }
-            }
-        }
-    }
-
-    // scene
-    for (int col = 0; col < Cols; ++col) {
-        int index = SceneRow * Cols + col;
-        if (_deviceLedState[index] != _ledState[index]) {
-            if (sendMidi(Cable, MidiMessage::makeNoteOn(0, 11 + 10 * (7 - col) + 8, _ledState[index]))) {
-                _deviceLedState[index] = _ledState[index];
-            }
-        }
-    }
+    // set leds command with led number and color
+    static const SysExLedCommand command = { { 0x00, 0x20, 0x29, 0x02, 0x18, 0x0a }, false };
 
-    // function
-    for (int col = 0; col < Cols; ++col) {
-        int index = FunctionRow * Cols + col;
-        if (_deviceLedState[index] != _ledState[index]) {
-            if (sendMidi(Cable, MidiMessage::makeControlChange(0, 104 + col, _ledState[index]))) {
-                _deviceLedState[index] = _ledState[index];
-            }
+    syncLedsSysEx(Cable, command, [] (int index) {
+        int row = index / Cols;
+        int col = index % Cols;
+        if (row == SceneRow) {
+            return 11 + 10 * (7 - col) + 8;
+        } else if (row == FunctionRow) {
+            return 104 + col;
         }
-    }
+        return 11 + 10 * (7 - row) + col;
+    });
 }
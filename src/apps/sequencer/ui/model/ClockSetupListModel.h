@@ -38,6 +38,7 @@ private:
         ShiftMode,
         ClockInputDivisor,
         ClockInputMode,
+        PllBandwidth,
         ClockOutputDivisor,
         ClockOutputSwing,
         ClockOutputPulse,
@@ -55,6 +56,7 @@ private:
         case ShiftMode:         return "Shift Mode";
         case ClockInputDivisor: return "Input Divisor";
         case ClockInputMode:    return "Input Mode";
+        case PllBandwidth:      return "Input PLL";
         case ClockOutputDivisor:return "Output Divisor";
         case ClockOutputSwing:  return "Output Swing";
         case ClockOutputPulse:  return "Output Pulse";
@@ -86,6 +88,9 @@ private:
         case ClockInputMode:
             _clockSetup.printClockInputMode(str);
             break;
+        case PllBandwidth:
+            _clockSetup.printPllBandwidth(str);
+            break;
         case ClockOutputDivisor:
             _clockSetup.printClockOutputDivisor(str);
             break;
@@ -129,6 +134,9 @@ private:
         case ClockInputMode:
             _clockSetup.editClockInputMode(value, shift);
             break;
+        case PllBandwidth:
+            _clockSetup.editPllBandwidth(value, shift);
+            break;
         case ClockOutputDivisor:
             _clockSetup.editClockOutputDivisor(value, shift);
             break;
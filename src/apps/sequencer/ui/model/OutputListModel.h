@@ -24,6 +24,7 @@ public:
     enum ControlChangeItem {
         ControlNumber = Last,
         ControlSource,
+        ControlDelta,
         LastControlChangeItem,
     };
 
@@ -81,6 +82,7 @@ private:
             switch (ControlChangeItem(item)) {
             case ControlNumber: return "Control Number";
             case ControlSource: return "Control Source";
+            case ControlDelta:  return "Control Delta";
             case LastControlChangeItem: break;
             }
         }
@@ -126,6 +128,9 @@ private:
             case ControlSource:
                 _output.printControlSource(str);
                 break;
+            case ControlDelta:
+                _output.printControlDelta(str);
+                break;
             case LastControlChangeItem:
                 break;
             }
@@ -166,6 +171,9 @@ private:
             case ControlSource:
                 _output.editControlSource(value, shift);
                 break;
+            case ControlDelta:
+                _output.editControlDelta(value, shift);
+                break;
             case LastControlChangeItem:
                 break;
             }
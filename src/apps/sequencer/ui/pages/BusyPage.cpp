@@ -2,6 +2,8 @@
 
 #include "ui/painters/WindowPainter.h"
 
+#include "model/FileManager.h"
+
 static void drawProgressBar(Canvas &canvas, int x, int y, int w, int h, int stripeLength, int stripeOffset) {
     canvas.setBlendMode(BlendMode::Set);
     canvas.setColor(Color::Bright);
@@ -15,6 +17,13 @@ static void drawProgressBar(Canvas &canvas, int x, int y, int w, int h, int stri
     }
 }
 
+static void drawProgressBar(Canvas &canvas, int x, int y, int w, int h, float progress) {
+    canvas.setBlendMode(BlendMode::Set);
+    canvas.setColor(Color::Bright);
+    canvas.drawRect(x, y, w, h);
+    canvas.fillRect(x, y, int(w * std::min(1.f, progress)), h);
+}
+
 BusyPage::BusyPage(PageManager &manager, PageContext &context) :
     BasePage(manager, context)
 {}
@@ -39,7 +48,13 @@ void BusyPage::draw(Canvas &canvas) {
 
     canvas.drawTextCentered(0, 32 - 16, Width, 8, _text);
 
-    drawProgressBar(canvas, 16, 32 - 4, Width - 32, 8, 16, (os::ticks() / os::time::ms(50)) % 16);
+    // show actual progress of file tasks reporting it
+    float progress = FileManager::taskProgress();
+    if (progress >= 0.f) {
+        drawProgressBar(canvas, 16, 32 - 4, Width - 32, 8, progress);
+    } else {
+        drawProgressBar(canvas, 16, 32 - 4, Width - 32, 8, 16, (os::ticks() / os::time::ms(50)) % 16);
+    }
 }
 
 void BusyPage::updateLeds(Leds &leds) {
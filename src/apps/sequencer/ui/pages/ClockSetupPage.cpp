@@ -13,6 +13,12 @@ ClockSetupPage::ClockSetupPage(PageManager &manager, PageContext &context) :
 void ClockSetupPage::draw(Canvas &canvas) {
     WindowPainter::clear(canvas);
     WindowPainter::drawHeader(canvas, _model, _engine, "CLOCK");
+
+    // slave clock PLL lock indicator
+    const auto &clock = _engine.clock();
+    if (clock.activeMode() == Clock::Mode::Slave && clock.isRunning() && clock.slavePllEnabled()) {
+        WindowPainter::drawActiveFunction(canvas, clock.slaveLocked() ? "LOCKED" : "UNLOCKED");
+    }
     WindowPainter::drawFooter(canvas);
 
     ListPage::draw(canvas);
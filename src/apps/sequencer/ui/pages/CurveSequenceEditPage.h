@@ -17,6 +17,11 @@ public:
     virtual void exit() override;
 
     virtual void draw(Canvas &canvas) override;
+    virtual Dependency dependencies() const override {
+        // play cursor moves within steps while the clock is running
+        return SelectedTrackDependency | StepDataDependency | PlayPositionDependency |
+            (_engine.clockRunning() ? AnimationDependency : NoDependency);
+    }
     virtual void updateLeds(Leds &leds) override;
 
     virtual void keyDown(KeyEvent &event) override;
@@ -5,6 +5,7 @@
 #include "engine/CvInput.h"
 #include "engine/CvOutput.h"
 
+#include "core/profiler/Profiler.h"
 #include "core/utils/StringBuilder.h"
 
 enum class Function {
@@ -17,6 +18,8 @@ enum class Function {
 
 static const char *functionNames[] = { "CV IN", "CV OUT", "MIDI", "STATS", "Version", nullptr };
 
+static const int ProfilerRows = 4;
+
 static void formatMidiMessage(StringBuilder &eventStr, StringBuilder &dataStr, const MidiMessage &msg) {
     if (msg.isChannelMessage()) {
         int channel = msg.channel() + 1;
@@ -79,6 +82,18 @@ MonitorPage::MonitorPage(PageManager &manager, PageContext &context) :
     BasePage(manager, context)
 {}
 
+int MonitorPage::activeFunction() const {
+    switch (_mode) {
+    case Mode::CvIn:        return int(Function::CvIn);
+    case Mode::CvOut:       return int(Function::CvOut);
+    case Mode::Midi:        return int(Function::Midi);
+    case Mode::Stats:       return int(Function::Stats);
+    case Mode::Profiler:    return int(Function::Stats);
+    case Mode::Version:     return int(Function::Version);
+    }
+    return -1;
+}
+
 void MonitorPage::enter() {
 }
 
@@ -88,8 +103,8 @@ void MonitorPage::exit() {
 void MonitorPage::draw(Canvas &canvas) {
     WindowPainter::clear(canvas);
     WindowPainter::drawHeader(canvas, _model, _engine, "MONITOR");
-    WindowPainter::drawActiveFunction(canvas, functionNames[int(_mode)]);
-    WindowPainter::drawFooter(canvas, functionNames, pageKeyState(), int(_mode));
+    WindowPainter::drawActiveFunction(canvas, _mode == Mode::Profiler ? "PROFILER" : functionNames[activeFunction()]);
+    WindowPainter::drawFooter(canvas, functionNames, pageKeyState(), activeFunction());
 
     canvas.setBlendMode(BlendMode::Set);
     canvas.setFont(Font::Tiny);
@@ -108,6 +123,9 @@ void MonitorPage::draw(Canvas &canvas) {
     case Mode::Stats:
         drawStats(canvas);
         break;
+    case Mode::Profiler:
+        drawProfiler(canvas);
+        break;
     case Mode::Version:
         drawVersion(canvas);
         break;
@@ -136,16 +154,24 @@ void MonitorPage::keyPress(KeyPressEvent &event) {
             _mode = Mode::Midi;
             break;
         case Function::Stats:
-            _mode = Mode::Stats;
+            // toggle between stats and profiler
+            _mode = _mode == Mode::Stats ? Mode::Profiler : Mode::Stats;
             break;
         case Function::Version:
             _mode = Mode::Version;
             break;
         }
     }
+
+    if (key.isEncoder() && _mode == Mode::Profiler) {
+        Profiler::reset();
+    }
 }
 
 void MonitorPage::encoder(EncoderEvent &event) {
+    if (_mode == Mode::Profiler) {
+        _profilerRow = clamp(_profilerRow + event.value(), 0, std::max(0, Profiler::intervalCount() - ProfilerRows));
+    }
 }
 
 void MonitorPage::midi(MidiEvent &event) {
@@ -209,9 +235,12 @@ void MonitorPage::drawMidi(Canvas &canvas) {
 void MonitorPage::drawStats(Canvas &canvas) {
     auto stats = _engine.stats();
 
+    // values are laid out in two columns
     auto drawValue = [&] (int index, const char *name, const char *value) {
-        canvas.drawText(10, 20 + index * 10, name);
-        canvas.drawText(100, 20 + index * 10, value);
+        int x = 10 + (index / 5) * 128;
+        int y = 20 + (index % 5) * 10;
+        canvas.drawText(x, y, name);
+        canvas.drawText(x + 72, y, value);
     };
 
     {
@@ -232,6 +261,98 @@ void MonitorPage::drawStats(Canvas &canvas) {
         drawValue(2, "USBMIDI OVF:", str);
     }
 
+    {
+        FixedStringBuilder<16> str("%d", stats.outputOverflow);
+        drawValue(3, "OUTPUT OVF:", str);
+    }
+
+    {
+        FixedStringBuilder<16> str("%d", stats.routingMidiOverflow);
+        drawValue(4, "ROUTE OVF:", str);
+    }
+
+    {
+        FixedStringBuilder<16> str("%d", stats.trackQueueOverflow);
+        drawValue(5, "QUEUE OVF:", str);
+    }
+
+    {
+        FixedStringBuilder<16> str("%d", stats.midiTxBytesSaved);
+        drawValue(6, "TX SAVED:", str);
+    }
+
+    {
+        FixedStringBuilder<16> str("%d", stats.midiTxDrops);
+        drawValue(7, "TX DROPS:", str);
+    }
+
+    {
+        // events per bulk transfer show how well messages are batched
+        FixedStringBuilder<16> str("%d/%d", stats.usbMidiTxEvents, stats.usbMidiTxTransfers);
+        drawValue(8, "USB TX:", str);
+    }
+
+    {
+        FixedStringBuilder<16> str("%d", stats.usbMidiRxEvents);
+        drawValue(9, "USB RX:", str);
+    }
+
+}
+
+void MonitorPage::drawProfiler(Canvas &canvas) {
+#if CONFIG_ENABLE_PROFILER
+    const int h = 8;
+
+    canvas.drawText(104, 18, "MIN");
+    canvas.drawText(136, 18, "MEAN");
+    canvas.drawText(168, 18, "MAX");
+
+    for (int row = 0; row < ProfilerRows; ++row) {
+        int index = _profilerRow + row;
+        if (index >= Profiler::intervalCount()) {
+            break;
+        }
+
+        const auto &interval = Profiler::interval(index);
+        int y = 18 + (row + 1) * h;
+
+        FixedStringBuilder<24> str;
+        if (interval.index >= 0) {
+            str("%s %d", interval.desc, interval.index + 1);
+        } else {
+            str("%s", interval.desc);
+        }
+        canvas.drawText(4, y, str);
+
+        if (interval.count == 0) {
+            continue;
+        }
+
+        str.reset();
+        str("%d", int(interval.min));
+        canvas.drawText(104, y, str);
+        str.reset();
+        str("%d", int(interval.mean()));
+        canvas.drawText(136, y, str);
+        str.reset();
+        str("%d", int(interval.max));
+        canvas.drawText(168, y, str);
+
+        // histogram, bar heights relative to the most populated bucket
+        uint32_t maxCount = 0;
+        for (int i = 0; i < Profiler::Interval::Buckets; ++i) {
+            maxCount = std::max(maxCount, interval.histogram[i]);
+        }
+        for (int i = 0; i < Profiler::Interval::Buckets; ++i) {
+            int barHeight = interval.histogram[i] > 0 ? 1 + (interval.histogram[i] * (h - 3)) / maxCount : 0;
+            canvas.setColor(i == Profiler::Interval::bucket(interval.last) ? Color::Bright : Color::Medium);
+            canvas.fillRect(200 + i * 4, y - barHeight, 3, barHeight);
+        }
+        canvas.setColor(Color::Bright);
+    }
+#else // CONFIG_ENABLE_PROFILER
+    canvas.drawTextCentered(0, 24, Width, 16, "PROFILER DISABLED");
+#endif // CONFIG_ENABLE_PROFILER
 }
 
 void MonitorPage::drawVersion(Canvas &canvas) {
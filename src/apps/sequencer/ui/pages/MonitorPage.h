@@ -25,6 +25,7 @@ private:
     void drawCvOut(Canvas &canvas);
     void drawMidi(Canvas &canvas);
     void drawStats(Canvas &canvas);
+    void drawProfiler(Canvas &canvas);
     void drawVersion(Canvas &canvas);
 
     enum class Mode : uint8_t {
@@ -32,11 +33,15 @@ private:
         CvOut,
         Midi,
         Stats,
+        Profiler,
         Version,
     };
 
+    int activeFunction() const;
+
     Mode _mode = Mode::CvIn;
     MidiMessage _lastMidiMessage;
     MidiPort _lastMidiMessagePort;
     uint32_t _lastMidiMessageTicks = -1;
+    int _profilerRow = 0;
 };
@@ -355,6 +355,8 @@ void NoteSequenceEditPage::encoder(EncoderEvent &event) {
     if (_stepSelection.any()) {
         _showDetail = true;
         _showDetailTicks = os::ticks();
+        // redraw to hide the detail once it timed out
+        _manager.scheduleDraw(_showDetailTicks + os::time::ms(500) + 1);
     } else {
         return;
     }
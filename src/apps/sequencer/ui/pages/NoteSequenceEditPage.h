@@ -17,6 +17,9 @@ public:
     virtual void exit() override;
 
     virtual void draw(Canvas &canvas) override;
+    virtual Dependency dependencies() const override {
+        return SelectedTrackDependency | StepDataDependency | PlayPositionDependency;
+    }
     virtual void updateLeds(Leds &leds) override;
 
     virtual void keyDown(KeyEvent &event) override;
@@ -179,11 +179,13 @@ void ProjectPage::initRoute() {
 }
 
 void ProjectPage::saveProjectToSlot(int slot) {
-    _engine.suspend();
+    // stage the project and write it in the background, the engine keeps running,
+    // the busy page blocks edits until the project is written
+    FileManager::stageProject(_project, slot);
     _manager.pages().busy.show("SAVING PROJECT ...");
 
-    FileManager::task([this, slot] () {
-        return FileManager::writeProject(_project, slot);
+    FileManager::task([this] () {
+        return FileManager::writeStagedProject(_project);
     }, [this] (fs::Error result) {
         if (result == fs::OK) {
             showMessage("PROJECT SAVED");
@@ -192,7 +194,6 @@ void ProjectPage::saveProjectToSlot(int slot) {
         }
         // TODO lock ui mutex
         _manager.pages().busy.close();
-        _engine.resume();
     });
 }
 
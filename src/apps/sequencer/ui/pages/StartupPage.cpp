@@ -4,8 +4,13 @@
 
 #include "model/FileManager.h"
 
+#include "core/profiler/Profiler.h"
+
 #include "os/os.h"
 
+PROFILER_EVENT(bootProjectPlayable, "BOOT PROJECT PLAYABLE")
+PROFILER_EVENT(bootProjectLoaded, "BOOT PROJECT LOADED")
+
 StartupPage::StartupPage(PageManager &manager, PageContext &context) :
     BasePage(manager, context)
 {
@@ -13,13 +18,34 @@ StartupPage::StartupPage(PageManager &manager, PageContext &context) :
 }
 
 void StartupPage::draw(Canvas &canvas) {
+    // load the last project in two stages, the engine is resumed as soon as the playing patterns are loaded
     if (_state == State::Initial) {
         _state = State::Loading;
         _engine.suspend();
         FileManager::task([this] () {
-            return FileManager::readLastProject(_model.project());
+            return FileManager::readLastProject(_model.project(), true);
         }, [this] (fs::Error result) {
+            // only the playing patterns are loaded, pattern changes wait for the remaining sequences
+            _engine.holdPlayState(true);
             _engine.resume();
+            PROFILER_EVENT_MARK(bootProjectPlayable)
+            _state = State::Playable;
+        });
+    }
+
+    if (_state == State::Playable) {
+        _state = State::LoadingRemaining;
+        FileManager::task([this] () {
+            return FileManager::readDeferredProjectChunks(_model.project());
+        }, [this] (fs::Error result) {
+            if (result != fs::OK) {
+                // do not keep a partially loaded project
+                _engine.suspend();
+                _model.project().clear();
+                _engine.resume();
+            }
+            _engine.holdPlayState(false);
+            PROFILER_EVENT_MARK(bootProjectLoaded)
             _state = State::Ready;
         });
     }
@@ -15,6 +15,8 @@ private:
     enum class State {
         Initial,
         Loading,
+        Playable,
+        LoadingRemaining,
         Ready,
     };
 
@@ -16,6 +16,9 @@ public:
 
     virtual void updateLeds(Leds &leds) override;
 
+    // top page only handles events and leds, it does not draw
+    virtual Dependency dependencies() const override { return NoDependency; }
+
     virtual void keyDown(KeyEvent &event) override;
     virtual void keyUp(KeyEvent &event) override;
     virtual void keyPress(KeyPressEvent &event) override;
@@ -364,7 +364,7 @@ private:
         drawTitle(_canvas, titles[int(_mode)]);
         drawLog(_canvas);
 
-        lcd.draw(_frameBufferData);
+        lcd.draw(_frameBuffer.data());
     }
 
     void drawClear(Canvas &canvas) {
@@ -468,8 +468,8 @@ private:
     std::array<int, 8> _cvOutputs;
     std::array<bool, 8> _gateOutputs;
 
-    uint8_t _frameBufferData[256 * 64];
-    FrameBuffer8bit _frameBuffer;
+    uint32_t _frameBufferData[256 * 64 / FrameBuffer4bit::PixelsPerWord];
+    FrameBuffer4bit _frameBuffer;
     Canvas _canvas;
     float _brightness = 1.0;
 };
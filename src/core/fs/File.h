@@ -15,6 +15,7 @@ public:
         Read,
         Write,
         Append,
+        ReadWrite,
     };
 
     File() = default;
@@ -34,6 +35,7 @@ public:
         case Read:      _error = Error(f_open(_file, path, FA_READ)); break;
         case Write:     _error = Error(f_open(_file, path, FA_WRITE | FA_CREATE_ALWAYS)); break;
         case Append:    _error = Error(f_open(_file, path, FA_WRITE | FA_OPEN_APPEND)); break;
+        case ReadWrite: _error = Error(f_open(_file, path, FA_READ | FA_WRITE | FA_OPEN_EXISTING)); break;
         default:        _error = INVALID_PARAMETER;
         }
         return _error;
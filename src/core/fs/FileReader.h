@@ -60,6 +60,16 @@ public:
         return _error;
     }
 
+    // discards buffered data and moves the read position
+    Error seek(size_t offset) {
+        if (_error == OK) {
+            _error = _file.seek(offset);
+            _bufferSize = 0;
+            _pos = 0;
+        }
+        return _error;
+    }
+
 private:
     static constexpr size_t BufferSize = 512;
 
@@ -16,8 +16,8 @@ namespace fs {
  */
 class FileWriter {
 public:
-    FileWriter(const char *path) {
-        _error = _file.open(path, File::Write);
+    FileWriter(const char *path, File::Mode mode = File::Write) {
+        _error = _file.open(path, mode);
     }
 
     ~FileWriter() {
@@ -58,6 +58,18 @@ public:
         return _error;
     }
 
+    // flushes buffered data and moves the write position (only useful with File::ReadWrite)
+    Error seek(size_t offset) {
+        if (_error == OK && _pos > 0) {
+            _error = _file.writeAll(_buffer, _pos);
+            _pos = 0;
+        }
+        if (_error == OK) {
+            _error = _file.seek(offset);
+        }
+        return _error;
+    }
+
 private:
     static constexpr size_t BufferSize = 512;
 
@@ -1,23 +1,52 @@
 #pragma once
 
+#include <algorithm>
+
 #include <cstdint>
 
+// Blend functors for 4 bit pixels. operator() blends a single pixel value, word() blends 8 packed pixels at once.
+// Word blends treat every nibble as a separate lane and saturate at 0x0 and 0xf.
 namespace blit {
+    // splits the packed pixels into two sets of byte lanes, applies the operation and merges the result
+    template<typename Op>
+    static inline uint32_t lanes(uint32_t dst, uint32_t color, Op op) {
+        uint32_t lo = op(dst & 0x0f0f0f0f, color & 0x0f0f0f0f);
+        uint32_t hi = op((dst >> 4) & 0x0f0f0f0f, (color >> 4) & 0x0f0f0f0f);
+        return lo | (hi << 4);
+    }
+
     struct set {
-        void operator()(FrameBuffer8bit &frameBuffer, int x, int y, uint8_t color) {
-            frameBuffer(x, y) = color;
+        uint8_t operator()(uint8_t dst, uint8_t color) const {
+            return color;
+        }
+        uint32_t word(uint32_t dst, uint32_t color) const {
+            return color;
         }
     };
     struct add {
-        void operator()(FrameBuffer8bit &frameBuffer, int x, int y, uint8_t color) {
-            // frameBuffer(x, y) = std::min(0xff, int(frameBuffer(x, y)) + color);
-            frameBuffer(x, y) += color;
+        uint8_t operator()(uint8_t dst, uint8_t color) const {
+            return std::min(0xf, dst + color);
+        }
+        uint32_t word(uint32_t dst, uint32_t color) const {
+            return lanes(dst, color, [] (uint32_t a, uint32_t b) {
+                // lanes hold 0..30, bit 4 is set on overflow
+                uint32_t sum = a + b;
+                uint32_t overflow = ((sum & 0x10101010) >> 4) * 0xf;
+                return (sum | overflow) & 0x0f0f0f0f;
+            });
         }
     };
     struct sub {
-        void operator()(FrameBuffer8bit &frameBuffer, int x, int y, uint8_t color) {
-            // frameBuffer(x, y) = std::max(0x00, int(frameBuffer(x, y)) - color);
-            frameBuffer(x, y) -= std::min(frameBuffer(x, y), color);
+        uint8_t operator()(uint8_t dst, uint8_t color) const {
+            return dst - std::min(dst, color);
+        }
+        uint32_t word(uint32_t dst, uint32_t color) const {
+            return lanes(dst, color, [] (uint32_t a, uint32_t b) {
+                // bit 4 is cleared in lanes that borrowed
+                uint32_t diff = (a | 0x10101010) - b;
+                uint32_t valid = ((diff & 0x10101010) >> 4) * 0xf;
+                return diff & valid;
+            });
         }
     };
 };
@@ -15,6 +15,23 @@ static const BitmapFont &bitmapFont(Font font) {
     }
 }
 
+// one glyph per character in [first, last] of the font
+static constexpr int tiny5x5GlyphCount = sizeof(tiny5x5_glyphs) / sizeof(tiny5x5_glyphs[0]);
+static constexpr int ati8x8GlyphCount = sizeof(ati8x8_glyphs) / sizeof(ati8x8_glyphs[0]);
+
+static uint8_t tiny5x5Rows[tiny5x5GlyphCount * FontCache::MaxHeight];
+static uint8_t ati8x8Rows[ati8x8GlyphCount * FontCache::MaxHeight];
+static FontCache tiny5x5Cache(tiny5x5, tiny5x5Rows, sizeof(tiny5x5Rows));
+static FontCache ati8x8Cache(ati8x8, ati8x8Rows, sizeof(ati8x8Rows));
+
+static FontCache &fontCache(Font font) {
+    switch (font) {
+    case Font::Tiny: return tiny5x5Cache;
+    case Font::Small: return ati8x8Cache;
+    default: return tiny5x5Cache;
+    }
+}
+
 static const int bitmapFontHeight(Font font) {
     switch (font) {
     case Font::Tiny: return 6;
@@ -104,8 +121,17 @@ void Canvas::drawBitmap4bit(int x, int y, int w, int h, const uint8_t *bitmap) {
     }
 }
 
+void Canvas::drawGlyph(FontCache &fontCache, int x, int y, char c) {
+    switch (_blendMode) {
+    case BlendMode::Set: drawGlyph<blit::set>(fontCache, x, y, c); break;
+    case BlendMode::Add: drawGlyph<blit::add>(fontCache, x, y, c); break;
+    case BlendMode::Sub: drawGlyph<blit::sub>(fontCache, x, y, c); break;
+    }
+}
+
 void Canvas::drawText(int x, int y, const char *str) {
-    const auto &font = bitmapFont(_font);
+    auto &cache = fontCache(_font);
+    const auto &font = cache.font();
 
     int ox = x;
     while (*str != '\0') {
@@ -118,13 +144,8 @@ void Canvas::drawText(int x, int y, const char *str) {
         if (c < font.first || c > font.last) {
             continue;
         }
-        const auto &g = font.glyphs[c - font.first];
-        const uint8_t *bitmap = &font.bitmap[g.offset];
-        switch (font.bpp) {
-        case 1: drawBitmap1bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
-        case 4: drawBitmap4bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
-        }
-        x += g.xAdvance;
+        drawGlyph(cache, x, y, c);
+        x += font.glyphs[c - font.first].xAdvance;
     }
 }
 
@@ -162,7 +183,8 @@ void Canvas::drawTextAligned(int x, int y, int w, int h, HorizontalAlign horizon
 }
 
 void Canvas::drawTextMultiline(int x, int y, int w, const char *str) {
-    const auto &font = bitmapFont(_font);
+    auto &cache = fontCache(_font);
+    const auto &font = cache.font();
 
     int ox = x;
     while (*str != '\0') {
@@ -182,11 +204,7 @@ void Canvas::drawTextMultiline(int x, int y, int w, const char *str) {
             str--;
             continue;
         }
-        const uint8_t *bitmap = &font.bitmap[g.offset];
-        switch (font.bpp) {
-        case 1: drawBitmap1bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
-        case 4: drawBitmap4bit(x + g.xOffset, y + g.yOffset, g.width, g.height, bitmap); break;
-        }
+        drawGlyph(cache, x, y, c);
         x += g.xAdvance;
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "FrameBuffer.h"
+#include "FontCache.h"
 
 #include <algorithm>
 
@@ -42,7 +43,7 @@ enum class VerticalAlign {
 
 class Canvas {
 public:
-    Canvas(FrameBuffer8bit &frameBuffer, float &brightness) :
+    Canvas(FrameBuffer4bit &frameBuffer, float &brightness) :
         _frameBuffer(frameBuffer),
         _right(frameBuffer.width() - 1),
         _bottom(frameBuffer.height() - 1),
@@ -51,7 +52,7 @@ public:
     }
 
     uint8_t color() const { return _color; }
-    void setColorValue(uint8_t color) { _color = color * _brightness; }
+    void setColorValue(uint8_t color) { _color = std::min(0xf, int(color * _brightness)); }
     void setColor(Color color) { setColorValue(color); }
 
     BlendMode blendMode() const { return _blendMode; }
@@ -112,46 +113,63 @@ private:
     }
 
     template<typename Blit>
-    void point(int x, int y) {
+    void blendPixel(int x, int y, uint8_t color) {
+        Blit blit;
+        _frameBuffer.set(x, y, blit(_frameBuffer.get(x, y), color));
+    }
+
+    // blends the pixels [x0, x1] of row y a word at a time
+    template<typename Blit>
+    void blendSpan(int x0, int x1, int y) {
         Blit blit;
+        const uint32_t value = FrameBuffer4bit::wordValue(_color);
+        uint32_t *row = _frameBuffer.row(y);
+        int w0 = x0 / FrameBuffer4bit::PixelsPerWord;
+        int w1 = x1 / FrameBuffer4bit::PixelsPerWord;
+        for (int w = w0; w <= w1; ++w) {
+            uint32_t mask = FrameBuffer4bit::spanMask(w == w0 ? x0 & 7 : 0, w == w1 ? x1 & 7 : 7);
+            row[w] = (row[w] & ~mask) | (blit.word(row[w], value) & mask);
+        }
+    }
+
+    template<typename Blit>
+    void point(int x, int y) {
         if (inside(x, y)) {
-            blit(_frameBuffer, x, y, _color);
+            blendPixel<Blit>(x, y, _color);
+            _frameBuffer.markDirty(y, y);
         }
     }
 
     template<typename Blit>
     void hline(int x, int y, int w) {
-        Blit blit;
-        if (vinside(y)) {
+        if (vinside(y) && w > 0) {
             int x0 = x, x1 = x + w - 1;
             hclip(x0);
             hclip(x1);
-            for (int x = x0; x <= x1; ++x) {
-                blit(_frameBuffer, x, y, _color);
-            }
+            blendSpan<Blit>(x0, x1, y);
+            _frameBuffer.markDirty(y, y);
         }
     }
 
     template<typename Blit>
     void vline(int x, int y, int h) {
-        Blit blit;
         if (hinside(x)) {
             int y0 = y, y1 = y + h - 1;
             vclip(y0);
             vclip(y1);
             for (int y = y0; y <= y1; ++y) {
-                blit(_frameBuffer, x, y, _color);
+                blendPixel<Blit>(x, y, _color);
             }
+            _frameBuffer.markDirty(y0, y1);
         }
     }
 
     template<typename Blit>
     void line(float x0, float y0, float x1, float y1) {
-        Blit blit;
-
         auto plot = [&] (int x, int y, float c) {
             if (inside(x, y)) {
-                blit(_frameBuffer, x, y, _color * c);
+                blendPixel<Blit>(x, y, _color * c);
+                _frameBuffer.markDirty(y, y);
             }
         };
 
@@ -230,18 +248,21 @@ private:
 
     template<typename Blit>
     void fillRect(int x, int y, int w, int h) {
-        Blit blit;
+        if (w <= 0 || h <= 0) {
+            return;
+        }
         int x0 = x, x1 = x + w - 1;
         int y0 = y, y1 = y + h - 1;
         clip(x0, y0);
         clip(x1, y1);
         for (int y = y0; y <= y1; ++y) {
-            for (int x = x0; x <= x1; ++x) {
-                blit(_frameBuffer, x, y, _color);
-            }
+            blendSpan<Blit>(x0, x1, y);
         }
+        _frameBuffer.markDirty(y0, y1);
     }
 
+    // blits the bitmap a word at a time, pixels of a word are collected into a color and coverage mask
+    // and blended at once, pixels not set in the bitmap are blended with color 0 (clears them in set mode)
     template<typename Blit, size_t Bpp>
     void drawBitmap(int x, int y, int w, int h, const uint8_t *bitmap) {
         Blit blit;
@@ -250,26 +271,92 @@ private:
         if (x0 > _right || x1 < 0 || y0 > _bottom || y1 < 0) {
             return;
         }
+        _frameBuffer.markDirty(y0, y1);
 
         const uint8_t mask = (1 << Bpp) - 1;
         int shift = 0;
         for (int y = y0; y <= y1; ++y) {
+            uint32_t *row = vinside(y) ? _frameBuffer.row(y) : nullptr;
+            int wordIndex = -1;
+            uint32_t wordColor = 0;
+            uint32_t wordMask = 0;
             for (int x = x0; x <= x1; ++x) {
-                // uint8_t pixel = ((*bitmap >> shift) & mask) << (8 - Bpp);
-                uint8_t pixel = ((*bitmap >> shift) & mask) * _color;
+                uint8_t pixel = std::min(0xf, ((*bitmap >> shift) & mask) * _color);
                 shift += Bpp;
                 if (shift >= 8) {
                     ++bitmap;
                     shift = 0;
                 }
-                if (inside(x, y)) {
-                    blit(_frameBuffer, x, y, pixel);
+                if (row && hinside(x)) {
+                    int index = x / FrameBuffer4bit::PixelsPerWord;
+                    if (index != wordIndex) {
+                        if (wordMask) {
+                            row[wordIndex] = (row[wordIndex] & ~wordMask) | (blit.word(row[wordIndex], wordColor) & wordMask);
+                        }
+                        wordIndex = index;
+                        wordColor = 0;
+                        wordMask = 0;
+                    }
+                    wordColor |= uint32_t(pixel) << FrameBuffer4bit::shift(x);
+                    wordMask |= 0xfu << FrameBuffer4bit::shift(x);
+                }
+            }
+            if (wordMask) {
+                row[wordIndex] = (row[wordIndex] & ~wordMask) | (blit.word(row[wordIndex], wordColor) & wordMask);
+            }
+        }
+    }
+
+    void drawGlyph(FontCache &fontCache, int x, int y, char c);
+
+    // blits a prerasterized glyph a row at a time, each row covers at most two words of the frame buffer,
+    // pixels not set in the glyph are blended with color 0 (clears them in set mode)
+    template<typename Blit>
+    void drawGlyph(FontCache &fontCache, int x, int y, char c) {
+        Blit blit;
+        const auto &g = fontCache.glyph(c);
+        int x0 = x + g.xOffset;
+        int y0 = y + g.yOffset;
+        int x1 = x0 + g.width - 1;
+        int y1 = y0 + g.height - 1;
+        if (g.width == 0 || x0 > _right || x1 < 0 || y0 > _bottom || y1 < 0) {
+            return;
+        }
+
+        // coverage of the glyph box clipped horizontally
+        uint32_t cover = (1u << g.width) - 1;
+        if (x0 < 0) {
+            cover &= ~0u << -x0;
+        }
+        if (x1 > _right) {
+            cover &= (1u << (_right - x0 + 1)) - 1;
+        }
+
+        int wordIndex = (x0 >= 0 ? x0 : x0 - 7) / FrameBuffer4bit::PixelsPerWord;
+        int shift = x0 - wordIndex * FrameBuffer4bit::PixelsPerWord;
+        const uint32_t value = FrameBuffer4bit::wordValue(_color);
+        const uint8_t *rows = fontCache.rows(c);
+
+        int ys = std::max(0, y0);
+        int ye = std::min(_bottom, y1);
+        for (int y = ys; y <= ye; ++y) {
+            uint32_t *row = _frameBuffer.row(y);
+            uint32_t on = uint32_t(rows[y - y0] & cover) << shift;
+            uint32_t in = cover << shift;
+            for (int i = 0; i < 2; ++i) {
+                uint8_t inBits = in >> (i * 8);
+                if (inBits) {
+                    uint32_t &word = row[wordIndex + i];
+                    uint32_t mask = FrameBuffer4bit::pixelMask(inBits);
+                    uint32_t color = value & FrameBuffer4bit::pixelMask(on >> (i * 8));
+                    word = (word & ~mask) | (blit.word(word, color) & mask);
                 }
             }
         }
+        _frameBuffer.markDirty(ys, ye);
     }
 
-    FrameBuffer8bit &_frameBuffer;
+    FrameBuffer4bit &_frameBuffer;
     int _right;
     int _bottom;
     uint8_t _color = 0xf;
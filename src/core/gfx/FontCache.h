@@ -0,0 +1,68 @@
+#pragma once
+
+#include "fonts/BitmapFont.h"
+
+#include "core/Debug.h"
+
+#include <cstdint>
+
+// Bitmap font prerasterized into one bit mask per glyph row (bit 0 is the leftmost pixel).
+// Glyph bitmaps are packed continuously across rows, the cache unpacks them once so that
+// glyphs can be blitted a whole row at a time instead of decoding the bitmap pixel by pixel.
+class FontCache {
+public:
+    static constexpr int MaxWidth = 8;
+    static constexpr int MaxHeight = 8;
+
+    // rows must hold (font.last - font.first + 1) * MaxHeight entries
+    FontCache(const BitmapFont &font, uint8_t *rows, int rowsSize) :
+        _font(font),
+        _rows(rows),
+        _rowsSize(rowsSize)
+    {}
+
+    const BitmapFont &font() const { return _font; }
+
+    bool contains(char c) const { return c >= _font.first && c <= _font.last; }
+
+    const BitmapFontGlyph &glyph(char c) const { return _font.glyphs[c - _font.first]; }
+
+    const uint8_t *rows(char c) {
+        if (!_initialized) {
+            init();
+        }
+        return &_rows[(c - _font.first) * MaxHeight];
+    }
+
+private:
+    void init() {
+        int count = _font.last - _font.first + 1;
+        ASSERT(count * MaxHeight <= _rowsSize, "font cache too small");
+
+        for (int index = 0; index < count; ++index) {
+            const auto &g = _font.glyphs[index];
+            ASSERT(g.width <= MaxWidth && g.height <= MaxHeight, "glyph too large");
+            const uint8_t *bitmap = &_font.bitmap[g.offset];
+            uint8_t *rows = &_rows[index * MaxHeight];
+            int shift = 0;
+            for (int y = 0; y < MaxHeight; ++y) {
+                uint8_t bits = 0;
+                for (int x = 0; y < g.height && x < g.width; ++x) {
+                    bits |= ((*bitmap >> shift) & 1) << x;
+                    if (++shift >= 8) {
+                        ++bitmap;
+                        shift = 0;
+                    }
+                }
+                rows[y] = bits;
+            }
+        }
+
+        _initialized = true;
+    }
+
+    const BitmapFont &_font;
+    uint8_t *_rows;
+    int _rowsSize;
+    bool _initialized = false;
+};
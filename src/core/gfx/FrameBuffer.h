@@ -4,45 +4,102 @@
 
 #include <cstdint>
 
-template<typename T>
-class FrameBuffer {
+// Frame buffer storing 4 bit pixels packed into 32 bit words. Each byte holds two pixels with the left
+// pixel in the high nibble, which is the native pixel format of the display, so the buffer can be sent
+// without conversion. Rows are word aligned (width must be a multiple of 8) to allow word-wide span fills.
+class FrameBuffer4bit {
 public:
-    FrameBuffer(int width, int height, T *buffer) :
+    static constexpr int PixelsPerWord = 8;
+
+    FrameBuffer4bit(int width, int height, uint32_t *buffer) :
         _width(width),
         _height(height),
-        _size(width * height),
+        _rowWords(width / PixelsPerWord),
         _data(buffer)
-    {}
+    {
+        markDirty();
+    }
 
     int width() const { return _width; }
     int height() const { return _height; }
 
-    const T *data() const { return _data; }
-          T *data()       { return _data; }
+    // number of words per row
+    int rowWords() const { return _rowWords; }
+
+    const uint8_t *data() const { return reinterpret_cast<const uint8_t *>(_data); }
+          uint8_t *data()       { return reinterpret_cast<uint8_t *>(_data); }
+
+    const uint32_t *row(int y) const { return &_data[y * _rowWords]; }
+          uint32_t *row(int y)       { return &_data[y * _rowWords]; }
+
+    void fill(uint8_t value) {
+        std::fill(_data, _data + _height * _rowWords, wordValue(value));
+        markDirty();
+    }
 
-    const T *begin() const { return _data; }
-          T *begin()       { return _data; }
+    uint8_t get(int x, int y) const {
+        return (_data[y * _rowWords + x / PixelsPerWord] >> shift(x)) & 0xf;
+    }
 
-    const T *end() const { return &_data[_size]; }
-          T *end()       { return &_data[_size]; }
+    void set(int x, int y, uint8_t value) {
+        uint32_t &word = _data[y * _rowWords + x / PixelsPerWord];
+        word = (word & ~(0xfu << shift(x))) | (uint32_t(value & 0xf) << shift(x));
+    }
+
+    // bit position of the pixel within its word (little endian words, high nibble first)
+    static int shift(int x) {
+        return ((x & 7) >> 1) * 8 + ((x & 1) ? 0 : 4);
+    }
 
-    void fill(const T value) {
-        std::fill(begin(), end(), value);
+    // mask selecting the pixels [x0, x1] within a word (0 <= x0 <= x1 < 8)
+    static uint32_t spanMask(int x0, int x1) {
+        // pixels [0, x]
+        static const uint32_t headMask[8] = {
+            0x000000f0, 0x000000ff, 0x0000f0ff, 0x0000ffff, 0x00f0ffff, 0x00ffffff, 0xf0ffffff, 0xffffffff
+        };
+        return (x0 > 0 ? ~headMask[x0 - 1] : ~0u) & headMask[x1];
     }
 
-    const T &operator()(int x, int y) const {
-        return _data[y * _width + x];
+    // mask selecting the pixels of a word whose bits are set (bit 0 is the leftmost pixel)
+    static uint32_t pixelMask(uint8_t bits) {
+        static const uint16_t nibbleMask[16] = {
+            0x0000, 0x00f0, 0x000f, 0x00ff, 0xf000, 0xf0f0, 0xf00f, 0xf0ff,
+            0x0f00, 0x0ff0, 0x0f0f, 0x0fff, 0xff00, 0xfff0, 0xff0f, 0xffff
+        };
+        return nibbleMask[bits & 0xf] | (uint32_t(nibbleMask[bits >> 4]) << 16);
     }
 
-    T &operator()(int x, int y) {
-        return _data[y * _width + x];
+    // word with all pixels set to value
+    static uint32_t wordValue(uint8_t value) {
+        return (value & 0xf) * 0x11111111u;
+    }
+
+    // dirty rows track which part of the frame buffer was written since the last call to clearDirty()
+
+    bool isDirty() const { return _dirtyTop <= _dirtyBottom; }
+    int dirtyTop() const { return _dirtyTop; }
+    int dirtyBottom() const { return _dirtyBottom; }
+
+    void markDirty() {
+        _dirtyTop = 0;
+        _dirtyBottom = _height - 1;
+    }
+
+    void markDirty(int y0, int y1) {
+        _dirtyTop = std::max(0, std::min(_dirtyTop, y0));
+        _dirtyBottom = std::min(_height - 1, std::max(_dirtyBottom, y1));
+    }
+
+    void clearDirty() {
+        _dirtyTop = _height;
+        _dirtyBottom = -1;
     }
 
 private:
     int _width;
     int _height;
-    int _size;
-    T *_data;
+    int _rowWords;
+    uint32_t *_data;
+    int _dirtyTop;
+    int _dirtyBottom;
 };
-
-using FrameBuffer8bit = FrameBuffer<uint8_t>;
@@ -5,6 +5,7 @@
 #include <cstdlib>
 #include <cstdint>
 #include <functional>
+#include <utility>
 
 class VersionedSerializedReader {
 public:
@@ -14,7 +15,18 @@ public:
         _reader(reader),
         _readerVersion(readerVersion)
     {
-        _reader(&_dataVersion, sizeof(_dataVersion));
+        sourceRead(&_dataVersion, sizeof(_dataVersion));
+    }
+
+    // Reads directly from a source object providing read(void *data, size_t len) (e.g. fs::FileReader),
+    // avoiding the overhead of calling through std::function for every field.
+    template<typename Source, typename = decltype(std::declval<Source &>().read(nullptr, size_t(0)))>
+    VersionedSerializedReader(Source &source, uint32_t readerVersion) :
+        _source(&source),
+        _sourceReader(&readSource<Source>),
+        _readerVersion(readerVersion)
+    {
+        sourceRead(&_dataVersion, sizeof(_dataVersion));
     }
 
     uint32_t readerVersion() const { return _readerVersion; }
@@ -51,9 +63,10 @@ public:
         }
     }
 
+    // reads a block of data, prefer reading contiguous data in a single call over reading field by field
     void read(void *data, size_t len, uint32_t addedInVersion) {
         if (_dataVersion >= addedInVersion) {
-            _reader(data, len);
+            sourceRead(data, len);
             _hash(data, len);
         }
     }
@@ -66,14 +79,14 @@ public:
     void skip(size_t len, uint32_t addedInVersion, uint32_t removedInVersion) {
         if (_dataVersion >= addedInVersion && _dataVersion < removedInVersion) {
             uint8_t dummy[len];
-            _reader(dummy, len);
+            sourceRead(dummy, len);
             _hash(dummy, len);
         }
     }
 
     bool checkHash() {
         uint32_t hash;
-        _reader(&hash, sizeof(hash));
+        sourceRead(&hash, sizeof(hash));
         return _hash.result() == hash;
     }
 
@@ -86,7 +99,24 @@ public:
     }
 
 private:
+    using SourceReader = void (*)(void *, void *, size_t);
+
+    template<typename Source>
+    static void readSource(void *source, void *data, size_t len) {
+        static_cast<Source *>(source)->read(data, len);
+    }
+
+    void sourceRead(void *data, size_t len) {
+        if (_source) {
+            _sourceReader(_source, data, len);
+        } else {
+            _reader(data, len);
+        }
+    }
+
     Reader _reader;
+    void *_source = nullptr;
+    SourceReader _sourceReader = nullptr;
     uint32_t _readerVersion;
     uint32_t _dataVersion;
     FnvHash _hash;
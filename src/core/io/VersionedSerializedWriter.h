@@ -5,6 +5,7 @@
 #include <cstdlib>
 #include <cstdint>
 #include <functional>
+#include <utility>
 
 class VersionedSerializedWriter {
 public:
@@ -14,7 +15,18 @@ public:
         _writer(writer),
         _writerVersion(writerVersion)
     {
-        _writer(&_writerVersion, sizeof(_writerVersion));
+        sinkWrite(&_writerVersion, sizeof(_writerVersion));
+    }
+
+    // Writes directly to a sink object providing write(const void *data, size_t len) (e.g. fs::FileWriter),
+    // avoiding the overhead of calling through std::function for every field.
+    template<typename Sink, typename = decltype(std::declval<Sink &>().write(nullptr, size_t(0)))>
+    VersionedSerializedWriter(Sink &sink, uint32_t writerVersion) :
+        _sink(&sink),
+        _sinkWriter(&writeSink<Sink>),
+        _writerVersion(writerVersion)
+    {
+        sinkWrite(&_writerVersion, sizeof(_writerVersion));
     }
 
     uint32_t writerVersion() const { return _writerVersion; }
@@ -30,18 +42,36 @@ public:
         write(value);
     }
 
+    // writes a block of data, prefer writing contiguous data in a single call over writing field by field
     void write(const void *data, size_t len) {
         _hash(data, len);
-        _writer(data, len);
+        sinkWrite(data, len);
     }
 
     void writeHash() {
         uint32_t hash = _hash.result();
-        _writer(&hash, sizeof(hash));
+        sinkWrite(&hash, sizeof(hash));
     }
 
 private:
+    using SinkWriter = void (*)(void *, const void *, size_t);
+
+    template<typename Sink>
+    static void writeSink(void *sink, const void *data, size_t len) {
+        static_cast<Sink *>(sink)->write(data, len);
+    }
+
+    void sinkWrite(const void *data, size_t len) {
+        if (_sink) {
+            _sinkWriter(_sink, data, len);
+        } else {
+            _writer(data, len);
+        }
+    }
+
     Writer _writer;
+    void *_sink = nullptr;
+    SinkWriter _sinkWriter = nullptr;
     uint32_t _writerVersion;
     FnvHash _hash;
 };
@@ -43,12 +43,17 @@ void MidiMessage::setPayloadPool(uint8_t *data, size_t length) {
     _payloadPool.length = length;
 }
 
+size_t MidiMessage::maxPayloadLength() {
+    // slot length is stored in 8 bits
+    return std::min(_payloadPool.length / PayloadPool::SlotCount, size_t(255));
+}
+
 MidiMessage::PayloadID MidiMessage::allocatePayload(size_t length) {
     if (!_payloadPool.valid()) {
         return InvalidPayload;
     }
 
-    const size_t slotLength = _payloadPool.length / PayloadPool::SlotCount;
+    const size_t slotLength = maxPayloadLength();
     ASSERT(length <= slotLength, "Requested length does not fit.");
     if (length > slotLength) {
         return InvalidPayload;
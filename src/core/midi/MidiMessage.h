@@ -385,6 +385,9 @@ public:
 
     static void setPayloadPool(uint8_t *data, size_t length);
 
+    // max length of a single payload (system exclusive data without framing)
+    static size_t maxPayloadLength();
+
 private:
     static PayloadID allocatePayload(size_t length);
     static void incPayloadRefCount(PayloadID id);
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "MidiMessage.h"
+
+#include <array>
+
+#include <cstddef>
+#include <cstdint>
+
+// Transmit queue for serial MIDI output.
+// Messages are serialized byte by byte using running status. Control change and pitch bend
+// messages replace a pending message for the same channel and controller, so continuous
+// controllers only send their latest value when the output cannot keep up.
+// Real-time bytes (clock, start, stop) are sent through a separate lane which is served at the
+// next message boundary ahead of all queued messages, so they are delayed by at most one message.
+// push() is called by the sender and nextByte() by the transmit interrupt, the caller needs to
+// serialize access (i.e. by disabling interrupts while pushing).
+template<size_t Capacity>
+class MidiTxQueue {
+public:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+    struct Stats {
+        uint32_t bytesSaved;    // bytes not sent due to running status and coalescing
+        uint32_t coalesced;     // pending messages replaced by newer values
+        uint32_t drops;         // messages dropped due to a full queue
+        uint32_t realTimeDrops; // real-time bytes dropped due to a full real-time lane
+    };
+
+    MidiTxQueue() {
+        clear();
+    }
+
+    void clear() {
+        _read = 0;
+        _write = 0;
+        _index = 0;
+        _current.length = 0;
+        _runningStatus = 0;
+        _realTimeRead = 0;
+        _realTimeWrite = 0;
+        _stats = { 0, 0, 0, 0 };
+    }
+
+    // true if no more bytes are left to send
+    bool empty() const { return _read == _write && _index >= _current.length && _realTimeRead == _realTimeWrite; }
+
+    bool full() const { return _write - _read == Capacity; }
+
+    const Stats &stats() const { return _stats; }
+
+    // true if the message may be dropped or coalesced when the output cannot keep up
+    static bool isContinuous(const MidiMessage &message) {
+        return (message.isControlChange() && !isParameterControl(message.controlNumber())) || message.isPitchBend();
+    }
+
+    // queues a message, returns false if the message was dropped
+    bool push(const MidiMessage &message) {
+        if (isContinuous(message) && coalesce(message)) {
+            return true;
+        }
+
+        if (full()) {
+            ++_stats.drops;
+            return false;
+        }
+
+        auto &entry = _entries[_write & Mask];
+        entry.data[0] = message.raw()[0];
+        entry.data[1] = message.raw()[1];
+        entry.data[2] = message.raw()[2];
+        entry.length = message.length();
+        ++_write;
+
+        return true;
+    }
+
+    // queues a single byte real-time message, returns false if the byte was dropped
+    bool pushRealTime(uint8_t data) {
+        if (uint8_t(_realTimeWrite - _realTimeRead) == RealTimeCapacity) {
+            ++_stats.realTimeDrops;
+            return false;
+        }
+        _realTime[_realTimeWrite & RealTimeMask] = data;
+        ++_realTimeWrite;
+        return true;
+    }
+
+    // returns the next byte to send, false if the queue is empty
+    bool nextByte(uint8_t &data) {
+        if (_index >= _current.length) {
+            // real-time messages do not affect running status
+            if (_realTimeRead != _realTimeWrite) {
+                data = _realTime[_realTimeRead & RealTimeMask];
+                ++_realTimeRead;
+                return true;
+            }
+            if (_read == _write) {
+                return false;
+            }
+            _current = _entries[_read & Mask];
+            ++_read;
+            _index = 0;
+
+            uint8_t status = _current.data[0];
+            if (MidiMessage::isChannelMessage(status)) {
+                if (status == _runningStatus) {
+                    // omit status byte
+                    _index = 1;
+                    ++_stats.bytesSaved;
+                }
+                _runningStatus = status;
+            } else if (MidiMessage::isSystemMessage(status)) {
+                // system common messages cancel running status, real-time messages do not
+                _runningStatus = 0;
+            }
+        }
+
+        data = _current.data[_index++];
+        return true;
+    }
+
+    // sends the next channel message with its status byte
+    void resetRunningStatus() {
+        _runningStatus = 0;
+    }
+
+private:
+    static constexpr size_t Mask = Capacity - 1;
+    static constexpr size_t RealTimeCapacity = 8;
+    static constexpr size_t RealTimeMask = RealTimeCapacity - 1;
+
+    struct Entry {
+        uint8_t data[3];
+        uint8_t length;
+    };
+
+    // bank select and (n)rpn controllers form sequences that must not be reordered
+    static bool isParameterControl(uint8_t controlNumber) {
+        return controlNumber == 0 || controlNumber == 32 ||
+            controlNumber == 6 || controlNumber == 38 ||
+            (controlNumber >= 96 && controlNumber <= 101);
+    }
+
+    // replaces the value of a pending message for the same channel and controller
+    bool coalesce(const MidiMessage &message) {
+        uint8_t status = message.status();
+        for (size_t i = _write; i != _read; --i) {
+            auto &entry = _entries[(i - 1) & Mask];
+            if (entry.data[0] == status && (message.isPitchBend() || entry.data[1] == message.controlNumber())) {
+                entry.data[1] = message.raw()[1];
+                entry.data[2] = message.raw()[2];
+                ++_stats.coalesced;
+                _stats.bytesSaved += message.length();
+                return true;
+            }
+            // keep order with other messages on the same channel
+            bool sameChannel = MidiMessage::isChannelMessage(entry.data[0]) && (entry.data[0] & 0xf) == message.channel();
+            bool independentControl = MidiMessage::isChannelMessage<MidiMessage::ControlChange>(entry.data[0]) && !isParameterControl(entry.data[1]);
+            if (sameChannel && !independentControl) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    std::array<Entry, Capacity> _entries;
+    size_t _read;
+    size_t _write;
+    Entry _current;
+    uint8_t _index;
+    uint8_t _runningStatus;
+    std::array<uint8_t, RealTimeCapacity> _realTime;
+    uint8_t _realTimeRead;
+    uint8_t _realTimeWrite;
+    Stats _stats;
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "MidiMessage.h"
+
+#include <algorithm>
+
+#include <cstddef>
+#include <cstdint>
+
+// Packs MIDI messages into USB-MIDI event packets (4 bytes per event) for a single bulk OUT transfer.
+// As many events as fit into the endpoint's max packet size are collected before the buffer is sent.
+// System exclusive messages are split into multiple events and continue in the next transfer
+// if they do not fit into the remaining space.
+template<size_t Size>
+class UsbMidiPacketWriter {
+public:
+    static_assert(Size % 4 == 0, "size must be a multiple of the event size");
+
+    UsbMidiPacketWriter() {
+        setMaxSize(Size);
+    }
+
+    // sets the max packet size of the bulk OUT endpoint
+    void setMaxSize(size_t maxSize) {
+        _maxSize = std::min(Size, maxSize) & ~size_t(3);
+        reset();
+    }
+
+    // clears the buffer after it was sent, a partially written message continues with the next write
+    void clear() {
+        _size = 0;
+    }
+
+    // clears the buffer and drops a partially written message
+    void reset() {
+        _size = 0;
+        _sysExIndex = 0;
+    }
+
+    const uint8_t *data() const { return _data; }
+    size_t size() const { return _size; }
+    size_t events() const { return _size / 4; }
+
+    bool empty() const { return _size == 0; }
+    bool full() const { return _size + 4 > _maxSize; }
+
+    // packs the message into the buffer, returns false if the buffer is full before the message was
+    // written completely, in which case the same message has to be written again once the buffer was sent
+    bool write(uint8_t cable, const MidiMessage &message) {
+        if (message.isSystemExclusive()) {
+            return writeSystemExclusive(cable, message);
+        }
+        if (full()) {
+            return false;
+        }
+        uint8_t *p = &_data[_size];
+        p[0] = (cable << 4) | codeIndex(message);
+        p[1] = message.raw()[0];
+        p[2] = message.length() > 1 ? message.raw()[1] : 0;
+        p[3] = message.length() > 2 ? message.raw()[2] : 0;
+        _size += 4;
+        return true;
+    }
+
+private:
+    static uint8_t codeIndex(const MidiMessage &message) {
+        if (message.isChannelMessage()) {
+            return message.status() >> 4;
+        }
+        if (message.isSystemMessage()) {
+            switch (message.length()) {
+            case 2: return 0x2;
+            case 3: return 0x3;
+            default: return 0x5;
+            }
+        }
+        // single byte
+        return 0xf;
+    }
+
+    bool writeSystemExclusive(uint8_t cable, const MidiMessage &message) {
+        const uint8_t *payloadData = message.payloadData();
+        size_t payloadLength = message.payloadLength();
+        if (!payloadData || payloadLength == 0) {
+            return true;
+        }
+
+        // message is framed by 0xf0 and 0xf7
+        size_t messageLength = payloadLength + 2;
+        while (_sysExIndex < messageLength) {
+            if (full()) {
+                return false;
+            }
+            uint8_t *p = &_data[_size];
+            size_t remaining = messageLength - _sysExIndex;
+            size_t chunkSize = std::min(remaining, size_t(3));
+            // 0x4: starts or continues, 0x5/0x6/0x7: ends with 1/2/3 bytes
+            p[0] = (cable << 4) | (remaining <= 3 ? 0x4 + chunkSize : 0x4);
+            for (size_t i = 0; i < 3; ++i) {
+                uint8_t byte = 0;
+                if (i < chunkSize) {
+                    if (_sysExIndex == 0) {
+                        byte = 0xf0;
+                    } else if (_sysExIndex == messageLength - 1) {
+                        byte = 0xf7;
+                    } else {
+                        byte = payloadData[_sysExIndex - 1];
+                    }
+                    ++_sysExIndex;
+                }
+                p[1 + i] = byte;
+            }
+            _size += 4;
+        }
+        _sysExIndex = 0;
+        return true;
+    }
+
+    uint8_t _data[Size];
+    size_t _size;
+    size_t _maxSize;
+    size_t _sysExIndex;
+};
@@ -1,12 +1,17 @@
 #include "Profiler.h"
 
 #include "core/Debug.h"
+#include "core/utils/StringBuilder.h"
+
+#include <cinttypes>
 
 #if CONFIG_ENABLE_PROFILER
 int Profiler::_numIntervals;
 int Profiler::_numCounters;
+int Profiler::_numEvents;
 Profiler::Interval *Profiler::_intervals[Profiler::MaxIntervals];
 Profiler::Counter *Profiler::_counters[Profiler::MaxCounters];
+Profiler::Event *Profiler::_events[Profiler::MaxEvents];
 
 void Profiler::init() {
 }
@@ -18,19 +23,44 @@ void Profiler::dump() {
         DBG("Intervals:");
         for (int i = 0; i < _numIntervals; ++i) {
             const auto &interval = *_intervals[i];
-            DBG("  %s: %lu us", interval.desc, interval.avg);
+            FixedStringBuilder<24> desc("%s", interval.desc);
+            if (interval.index >= 0) {
+                desc(" %d", interval.index + 1);
+            }
+            DBG("  %s: last=%" PRIu32 " min=%" PRIu32 " mean=%" PRIu32 " max=%" PRIu32 " us (%" PRIu32 " samples)",
+                (const char *)(desc), interval.last, interval.count > 0 ? interval.min : 0, interval.mean(), interval.max, interval.count);
         }
     }
     if (_numCounters > 0) {
         DBG("Counters:");
         for (int i = 0; i < _numCounters; ++i) {
             const auto &counter = *_counters[i];
-            DBG("  %s: %lu", counter.desc, counter.count);
+            DBG("  %s: %" PRIu32, counter.desc, counter.count);
+        }
+    }
+    if (_numEvents > 0) {
+        DBG("Events:");
+        for (int i = 0; i < _numEvents; ++i) {
+            const auto &event = *_events[i];
+            if (event.marked) {
+                DBG("  %s: %" PRIu32 " us", event.desc, event.time);
+            } else {
+                DBG("  %s: -", event.desc);
+            }
         }
     }
     DBG("---------------------------------------------");
 }
 
+void Profiler::reset() {
+    for (int i = 0; i < _numIntervals; ++i) {
+        _intervals[i]->reset();
+    }
+    for (int i = 0; i < _numCounters; ++i) {
+        _counters[i]->count = 0;
+    }
+}
+
 void Profiler::registerInterval(Interval *interval) {
     if (_numIntervals < MaxIntervals) {
         _intervals[_numIntervals++] = interval;
@@ -47,4 +77,12 @@ void Profiler::registerCounter(Counter *counter) {
     }
 }
 
+void Profiler::registerEvent(Event *event) {
+    if (_numEvents < MaxEvents) {
+        _events[_numEvents++] = event;
+    } else {
+        DBG("Profiler: Too many profiler events");
+    }
+}
+
 #endif // CONFIG_ENABLE_PROFILER
@@ -12,9 +12,19 @@ class Profiler {
 public:
     static void init();
     static void dump();
+    static void reset();
 
     struct Interval {
+        // Samples are counted in log2 buckets, bucket 0 counts samples of 0us,
+        // bucket n counts samples in [2^(n-1), 2^n) us, last bucket is open ended.
+        static const int Buckets = 12;
+
+        Interval() {
+            reset();
+        }
+
         Interval(const char *desc) : desc(desc) {
+            reset();
             registerInterval(this);
         }
 
@@ -23,13 +33,74 @@ public:
         }
 
         inline void end() {
-            uint32_t end = HighResolutionTimer::us();
-            avg = end - start;
+            add(HighResolutionTimer::us() - start);
         }
 
-        const char *desc;
+        inline void add(uint32_t us) {
+            last = us;
+            min = us < min ? us : min;
+            max = us > max ? us : max;
+            sum += us;
+            ++count;
+            ++histogram[bucket(us)];
+        }
+
+        void reset() {
+            last = 0;
+            min = 0xffffffff;
+            max = 0;
+            sum = 0;
+            count = 0;
+            for (int i = 0; i < Buckets; ++i) {
+                histogram[i] = 0;
+            }
+        }
+
+        uint32_t mean() const { return count > 0 ? sum / count : 0; }
+
+        static inline int bucket(uint32_t us) {
+            int bucket = us == 0 ? 0 : 32 - __builtin_clz(us);
+            return bucket < Buckets ? bucket : Buckets - 1;
+        }
+
+        const char *desc = nullptr;
+        int index = -1;
         uint32_t start;
-        uint32_t avg;
+        uint32_t last;
+        uint32_t min;
+        uint32_t max;
+        uint64_t sum;
+        uint32_t count;
+        uint32_t histogram[Buckets];
+    };
+
+    // Array of intervals sharing the same description (i.e. one interval per track).
+    template<int Size>
+    struct IntervalArray {
+        IntervalArray(const char *desc) {
+            for (int i = 0; i < Size; ++i) {
+                intervals[i].desc = desc;
+                intervals[i].index = i;
+                registerInterval(&intervals[i]);
+            }
+        }
+
+        Interval &operator[](int index) { return intervals[index]; }
+
+        Interval intervals[Size];
+    };
+
+    // Measures the interval for the lifetime of the scope.
+    struct Scope {
+        Scope(Interval &interval) : interval(interval) {
+            interval.begin();
+        }
+
+        ~Scope() {
+            interval.end();
+        }
+
+        Interval &interval;
     };
 
     struct Counter {
@@ -42,20 +113,52 @@ public:
         }
 
         const char *desc;
-        uint32_t count;
+        uint32_t count = 0;
     };
 
+    // One-shot event recording the time (relative to HighResolutionTimer::init()) it first happened,
+    // used to build a timeline of the boot process.
+    struct Event {
+        Event(const char *desc) : desc(desc) {
+            registerEvent(this);
+        }
+
+        inline void mark() {
+            if (!marked) {
+                time = HighResolutionTimer::us();
+                marked = true;
+            }
+        }
+
+        const char *desc;
+        uint32_t time = 0;
+        bool marked = false;
+    };
+
+    static int intervalCount() { return _numIntervals; }
+    static const Interval &interval(int index) { return *_intervals[index]; }
+
+    static int counterCount() { return _numCounters; }
+    static const Counter &counter(int index) { return *_counters[index]; }
+
+    static int eventCount() { return _numEvents; }
+    static const Event &event(int index) { return *_events[index]; }
+
 private:
-    static const int MaxIntervals = 16;
+    static const int MaxIntervals = 32;
     static const int MaxCounters = 16;
+    static const int MaxEvents = 8;
 
     static void registerInterval(Interval *interval);
     static void registerCounter(Counter *counter);
+    static void registerEvent(Event *event);
 
     static int _numIntervals;
     static int _numCounters;
+    static int _numEvents;
     static Interval *_intervals[MaxIntervals];
     static Counter *_counters[MaxCounters];
+    static Event *_events[MaxEvents];
 };
 
 # define PROFILER_INTERVAL(_name_, _desc_) \
@@ -64,25 +167,51 @@ private:
     _name_##_profiler_interval.begin();
 # define PROFILER_INTERVAL_END(_name_) \
     _name_##_profiler_interval.end();
+# define PROFILER_INTERVAL_SCOPE(_name_) \
+    Profiler::Scope _name_##_profiler_scope(_name_##_profiler_interval);
+
+# define PROFILER_INTERVAL_ARRAY(_name_, _size_, _desc_) \
+    static Profiler::IntervalArray<_size_> _name_##_profiler_intervals(_desc_);
+# define PROFILER_INTERVAL_ARRAY_BEGIN(_name_, _index_) \
+    _name_##_profiler_intervals[_index_].begin();
+# define PROFILER_INTERVAL_ARRAY_END(_name_, _index_) \
+    _name_##_profiler_intervals[_index_].end();
 
 # define PROFILER_COUNTER(_name_, _desc_) \
     static Profiler::Counter _name_##_profiler_counter(_desc_);
-# define PROFILER_COUNTER_ADD(_num_) \
+# define PROFILER_COUNTER_ADD(_name_, _num_) \
     _name_##_profiler_counter.add(_num_);
 
+# define PROFILER_EVENT(_name_, _desc_) \
+    static Profiler::Event _name_##_profiler_event(_desc_);
+# define PROFILER_EVENT_MARK(_name_) \
+    _name_##_profiler_event.mark();
+
 #else // CONFIG_ENABLE_PROFILER
 
 class Profiler {
 public:
     static void init() {}
     static void dump() {}
+    static void reset() {}
+
+    static int intervalCount() { return 0; }
+    static int counterCount() { return 0; }
 };
 
 # define PROFILER_INTERVAL(_name_, _desc_)
 # define PROFILER_INTERVAL_BEGIN(_name_)
 # define PROFILER_INTERVAL_END(_name_)
+# define PROFILER_INTERVAL_SCOPE(_name_)
+
+# define PROFILER_INTERVAL_ARRAY(_name_, _size_, _desc_)
+# define PROFILER_INTERVAL_ARRAY_BEGIN(_name_, _index_)
+# define PROFILER_INTERVAL_ARRAY_END(_name_, _index_)
 
 # define PROFILER_COUNTER(_name_, _desc_)
-# define PROFILER_COUNTER_ADD(_num_)
+# define PROFILER_COUNTER_ADD(_name_, _num_)
+
+# define PROFILER_EVENT(_name_, _desc_)
+# define PROFILER_EVENT_MARK(_name_)
 
 #endif // CONFIG_ENABLE_PROFILER
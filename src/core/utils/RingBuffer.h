@@ -1,61 +1,84 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+
 #include <cstddef>
 
+// Lock-free single producer, single consumer ring buffer.
+// The producer (i.e. a task) may only call write(), the consumer (i.e. an interrupt handler) may only call read().
+// Indices run freely and are masked on access, so all Size entries are usable.
+// Writing to a full buffer is not allowed, writers need to check writable() first or use the bulk write.
 template<typename T, size_t Size>
 class RingBuffer {
 public:
+    static_assert(Size > 0 && (Size & (Size - 1)) == 0, "size must be a power of two");
+
     inline size_t size() const { return Size; }
 
-    inline bool empty() const { return _read == _write; }
+    inline bool empty() const { return readable() == 0; }
 
     inline bool full() const { return writable() == 0; }
 
-    inline size_t entries() const { return (_write - _read) % Size; }
+    inline size_t entries() const { return readable(); }
 
     inline size_t writable() const {
-        return (_read - _write - 1) % Size;
+        return Size - (_write.load(std::memory_order_acquire) - _read.load(std::memory_order_acquire));
     }
 
     inline size_t readable() const {
-        return (_write - _read) % Size;
+        return _write.load(std::memory_order_acquire) - _read.load(std::memory_order_acquire);
     }
 
     inline void write(T value) {
-        size_t write = _write;
-        _buffer[write] = value;
-        _write = (write + 1) % Size;
+        size_t write = _write.load(std::memory_order_relaxed);
+        _buffer[write & Mask] = value;
+        _write.store(write + 1, std::memory_order_release);
     }
 
-    inline void write(const T *data, size_t length) {
-        while (length--) {
-            write(*data++);
-        }
+    // writes up to length entries and returns the number of entries written
+    inline size_t write(const T *data, size_t length) {
+        size_t write = _write.load(std::memory_order_relaxed);
+        length = std::min(length, Size - (write - _read.load(std::memory_order_acquire)));
+        size_t index = write & Mask;
+        size_t first = std::min(length, Size - index);
+        std::copy(data, data + first, _buffer + index);
+        std::copy(data + first, data + length, _buffer);
+        _write.store(write + length, std::memory_order_release);
+        return length;
     }
 
     inline T read() {
-        size_t read = _read;
-        T value = _buffer[read];
-        _read = (read + 1) % Size;
+        size_t read = _read.load(std::memory_order_relaxed);
+        T value = _buffer[read & Mask];
+        _read.store(read + 1, std::memory_order_release);
         return value;
     }
 
     inline T readAndReplace(const T &replacement = T()) {
-        size_t read = _read;
-        T value = _buffer[read];
-        _buffer[read] = replacement;
-        _read = (read + 1) % Size;
+        size_t read = _read.load(std::memory_order_relaxed);
+        T value = _buffer[read & Mask];
+        _buffer[read & Mask] = replacement;
+        _read.store(read + 1, std::memory_order_release);
         return value;
     }
 
-    inline void read(T *data, size_t length) {
-        while (length--) {
-            read(*data++);
-        }
+    // reads up to length entries and returns the number of entries read
+    inline size_t read(T *data, size_t length) {
+        size_t read = _read.load(std::memory_order_relaxed);
+        length = std::min(length, _write.load(std::memory_order_acquire) - read);
+        size_t index = read & Mask;
+        size_t first = std::min(length, Size - index);
+        std::copy(_buffer + index, _buffer + index + first, data);
+        std::copy(_buffer, _buffer + length - first, data + first);
+        _read.store(read + length, std::memory_order_release);
+        return length;
     }
 
 private:
+    static constexpr size_t Mask = Size - 1;
+
     T _buffer[Size];
-    volatile size_t _read = 0;
-    volatile size_t _write = 0;
+    std::atomic<size_t> _read { 0 };
+    std::atomic<size_t> _write { 0 };
 };
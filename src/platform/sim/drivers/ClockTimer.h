@@ -3,6 +3,7 @@
 #include "sim/Simulator.h"
 
 #include <cstdint>
+#include <cmath>
 
 class ClockTimer {
 public:
@@ -41,6 +42,10 @@ public:
         _periodTicks = us * 0.001;
     }
 
+    uint32_t tickTime() const {
+        return uint32_t(std::round(_simulator.time() * 1000.0));
+    }
+
     void setListener(Listener *listener) {
         _listener = listener;
     }
@@ -53,10 +58,13 @@ private:
         double ticks = _simulator.ticks();
         while (ticks - _lastTicks >= _periodTicks) {
             _lastTicks += _periodTicks;
+            _simulator.dispatchScheduledInputs(_lastTicks);
+            _simulator.setTime(_lastTicks);
             if (_listener) {
                 _listener->onClockTimerTick();
             }
         }
+        _simulator.setTime(ticks);
     }
 
     sim::Simulator &_simulator;
@@ -18,6 +18,12 @@ public:
         }
     }
 
+    void write(uint8_t gates) {
+        for (int i = 0; i < 8; ++i) {
+            _simulator.writeGateOutput(i, (gates >> i) & 1);
+        }
+    }
+
     inline uint8_t gates() const { return _gates; }
 
     inline void setGates(uint8_t gates) {
@@ -5,6 +5,9 @@
 
 #include "SystemConfig.h"
 
+#include <algorithm>
+#include <array>
+
 #include <cstdint>
 #include <cstring>
 
@@ -19,12 +22,68 @@ public:
 
     void init() {}
 
-    void draw(uint8_t *frameBuffer) {
-        std::memcpy(_frameBuffer.data(), frameBuffer, _frameBuffer.size());
+    // takes a packed 4 bit frame buffer and models the double buffered dma pipeline of the hardware driver,
+    // a frame is dropped (and its rows are sent with the next frame) if the previous transfer has not completed yet
+    void draw(const uint8_t *frameBuffer, int top = 0, int bottom = Height - 1) {
+        if (!_frameBufferValid) {
+            top = 0;
+            bottom = Height - 1;
+        }
+        top = std::min(top, _pendingTop);
+        bottom = std::max(bottom, _pendingBottom);
+
+        int first = Height;
+        int last = -1;
+        for (int y = top; y <= bottom; ++y) {
+            if (!_frameBufferValid || std::memcmp(&_packedFrameBuffer[y * Width / 2], &frameBuffer[y * Width / 2], Width / 2) != 0) {
+                first = std::min(first, y);
+                last = y;
+            }
+        }
+
+        if (last < first) {
+            _pendingTop = Height;
+            _pendingBottom = -1;
+            return;
+        }
+
+        double time = _simulator.time();
+        if (time < _transferEnd) {
+            _pendingTop = top;
+            _pendingBottom = bottom;
+            ++_droppedFrames;
+            return;
+        }
+
+        std::memcpy(&_packedFrameBuffer[first * Width / 2], &frameBuffer[first * Width / 2], (last - first + 1) * Width / 2);
+        // unpack to 8 bit for the simulator
+        for (int i = first * Width / 2; i < (last + 1) * Width / 2; ++i) {
+            _frameBuffer[i * 2] = _packedFrameBuffer[i] >> 4;
+            _frameBuffer[i * 2 + 1] = _packedFrameBuffer[i] & 0xf;
+        }
+        _frameBufferValid = true;
+        _pendingTop = Height;
+        _pendingBottom = -1;
+        _transferEnd = time + (last - first + 1) * (Width / 2) * ByteTime;
         _simulator.writeLcd(_frameBuffer);
     }
 
+    void flush() {}
+
+    bool hasPending() const { return _pendingTop <= _pendingBottom; }
+
+    uint32_t droppedFrames() const { return _droppedFrames; }
+
 private:
+    // spi transfer time of a byte in milliseconds (21 MHz clock)
+    static constexpr double ByteTime = 8.0 / 21000.0;
+
     sim::Simulator &_simulator;
-    sim::FrameBuffer _frameBuffer;
+    std::array<uint8_t, Width * Height / 2> _packedFrameBuffer = {};
+    sim::FrameBuffer _frameBuffer = {};
+    bool _frameBufferValid = false;
+    int _pendingTop = Height;
+    int _pendingBottom = -1;
+    double _transferEnd = 0.0;
+    uint32_t _droppedFrames = 0;
 };
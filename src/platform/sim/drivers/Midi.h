@@ -1,14 +1,19 @@
 #pragma once
 
 #include "core/midi/MidiMessage.h"
+#include "core/midi/MidiParser.h"
+#include "core/midi/MidiTxQueue.h"
 
 #include "sim/Simulator.h"
 
+#include <algorithm>
 #include <functional>
 #include <deque>
 
 #include <cstdint>
 
+// Models the serial output at 31250 baud using the same transmit queue as the hardware driver.
+// Messages are written to the simulator once their last byte has been transmitted.
 class Midi : private sim::TargetInputHandler {
 public:
     typedef std::function<bool(uint8_t)> RecvFilter;
@@ -17,13 +22,32 @@ public:
         _simulator(sim::Simulator::instance())
     {
         _simulator.registerTargetInputObserver(this);
+        _simulator.addUpdateCallback([this] () { transmit(_simulator.time()); });
     }
 
     void init() {}
 
     bool send(const MidiMessage &message) {
-        _simulator.writeMidiOutput(sim::MidiEvent::makeMessage(0, message));
-        return true;
+        transmit(_simulator.time());
+
+        // block until there is space in the tx queue, continuous controllers are coalesced or dropped instead
+        if (!MidiTxQueue<TxQueueSize>::isContinuous(message)) {
+            while (_txQueue.full()) {
+                transmit(_txEnd);
+            }
+        }
+
+        bool result = _txQueue.push(message);
+        transmit(_simulator.time());
+        return result;
+    }
+
+    // sends a single byte real-time message ahead of queued messages
+    bool sendRealTime(uint8_t data) {
+        transmit(_simulator.time());
+        bool result = _txQueue.pushRealTime(data);
+        transmit(_simulator.time());
+        return result;
     }
 
     bool recv(MidiMessage *message) {
@@ -40,8 +64,36 @@ public:
     }
 
     uint32_t rxOverflow() const { return 0; }
+    uint32_t txBytesSaved() const { return _txQueue.stats().bytesSaved; }
+    uint32_t txDrops() const { return _txQueue.stats().drops; }
 
 private:
+    static constexpr size_t TxQueueSize = 32;
+    static constexpr double ByteTime = 0.32; // ms
+
+    // completes all bytes transmitted until the given time and starts sending the next byte
+    void transmit(double time) {
+        while (_txActive && _txEnd <= time) {
+            if (_txParser.feed(_txData)) {
+                double currentTime = _simulator.time();
+                _simulator.setTime(_txEnd);
+                _simulator.writeMidiOutput(sim::MidiEvent::makeMessage(0, _txParser.message()));
+                _simulator.setTime(currentTime);
+            }
+            if (_txQueue.nextByte(_txData)) {
+                _txEnd += ByteTime;
+            } else {
+                _txActive = false;
+                // resend status after idle times to let receivers resynchronize
+                _txQueue.resetRunningStatus();
+            }
+        }
+        if (!_txActive && _txQueue.nextByte(_txData)) {
+            _txActive = true;
+            _txEnd = std::max(_txEnd, time) + ByteTime;
+        }
+    }
+
     void writeMidiInput(sim::MidiEvent event) {
         if (event.port == 0 && event.kind == sim::MidiEvent::Message) {
             if (event.message.length() != 1 || !_recvFilter || !_recvFilter(event.message.status())) {
@@ -53,4 +105,10 @@ private:
     sim::Simulator &_simulator;
     std::deque<MidiMessage> _recvQueue;
     RecvFilter _recvFilter;
+
+    MidiTxQueue<TxQueueSize> _txQueue;
+    MidiParser _txParser;
+    uint8_t _txData;
+    bool _txActive = false;
+    double _txEnd = 0.0;
 };
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "sim/Simulator.h"
+
+#include <cstdint>
+#include <cmath>
+
+class OutputTimer {
+public:
+    struct Listener {
+        virtual void onOutputTimer() = 0;
+    };
+
+    OutputTimer() :
+        _simulator(sim::Simulator::instance())
+    {
+        _simulator.addUpdateCallback([this] () { update(); });
+    }
+
+    void init() {
+    }
+
+    uint32_t now() const {
+        return uint32_t(std::round(_simulator.time() * 1000.0));
+    }
+
+    void schedule(uint32_t time) {
+        _time = time;
+        _pending = true;
+    }
+
+    void cancel() {
+        _pending = false;
+    }
+
+    void setListener(Listener *listener) {
+        _listener = listener;
+    }
+
+private:
+    // dispatch all requests falling into the current simulator step at their exact time
+    void update() {
+        double ticks = _simulator.ticks();
+        uint32_t end = uint32_t(std::round(ticks * 1000.0));
+        while (_pending && int32_t(_time - end) <= 0) {
+            _pending = false;
+            _simulator.setTime(_time * 0.001);
+            if (_listener) {
+                _listener->onOutputTimer();
+            }
+        }
+        _simulator.setTime(ticks);
+    }
+
+    sim::Simulator &_simulator;
+    Listener *_listener = nullptr;
+    uint32_t _time = 0;
+    bool _pending = false;
+};
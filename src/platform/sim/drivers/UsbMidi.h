@@ -16,6 +16,15 @@ public:
     typedef std::function<void()> DisconnectHandler;
     typedef std::function<bool(uint8_t)> RecvFilter;
 
+    static constexpr int MaxDevices = 4;
+
+    struct DeviceStats {
+        uint32_t txEvents;
+        uint32_t txTransfers;
+        uint32_t rxEvents;
+        uint32_t rxOverflow;
+    };
+
     UsbMidi() :
         _simulator(sim::Simulator::instance())
     {
@@ -25,10 +34,17 @@ public:
     void init() {}
 
     bool send(uint8_t cable, const MidiMessage &message) {
+        countTxEvent();
         _simulator.writeMidiOutput(sim::MidiEvent::makeMessage(1, message));
         return true;
     }
 
+    bool sendRealTime(uint8_t cable, uint8_t data) {
+        countTxEvent();
+        _simulator.writeMidiOutput(sim::MidiEvent::makeMessage(1, MidiMessage(data)));
+        return true;
+    }
+
     bool recv(uint8_t *cable, MidiMessage *message) {
         if (!_recvQueue.empty()) {
             *cable = 0;
@@ -53,7 +69,22 @@ public:
 
     uint32_t rxOverflow() const { return 0; }
 
+    const DeviceStats &deviceStats(int device) const { return _deviceStats[device]; }
+
 private:
+    // events sent within the same millisecond share bulk transfers of 16 events like on the hardware
+    void countTxEvent() {
+        auto &stats = _deviceStats[0];
+        uint32_t tick = uint32_t(_simulator.ticks());
+        if (tick != _txTick || _txTransferEvents == 16) {
+            _txTick = tick;
+            _txTransferEvents = 0;
+            ++stats.txTransfers;
+        }
+        ++_txTransferEvents;
+        ++stats.txEvents;
+    }
+
     void writeMidiInput(sim::MidiEvent event) {
         if (event.port == 1) {
             switch (event.kind) {
@@ -68,6 +99,7 @@ private:
                 }
                 break;
             case sim::MidiEvent::Message:
+                ++_deviceStats[0].rxEvents;
                 if (event.message.length() != 1 || !_recvFilter || !_recvFilter(event.message.status())) {
                     _recvQueue.emplace_back(event.message);
                 }
@@ -82,4 +114,8 @@ private:
 
     sim::Simulator &_simulator;
     std::deque<MidiMessage> _recvQueue;
+
+    DeviceStats _deviceStats[MaxDevices] = {};
+    uint32_t _txTick = 0;
+    uint32_t _txTransferEvents = 0;
 };
@@ -135,6 +135,12 @@ namespace os {
         T _data[Length];
     };
 
+    class SchedulerLock {
+    public:
+        SchedulerLock() {}
+        ~SchedulerLock() {}
+    };
+
     class InterruptLock {
     public:
         InterruptLock() {}
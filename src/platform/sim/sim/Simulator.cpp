@@ -65,6 +65,25 @@ void Simulator::setDio(int pin, bool state) {
     writeDigitalInput(pin, state);
 }
 
+void Simulator::scheduleDio(double time, int pin, bool state) {
+    auto it = std::upper_bound(_scheduledInputs.begin(), _scheduledInputs.end(), time, [] (double time, const ScheduledInput &input) {
+        return time < input.time;
+    });
+    _scheduledInputs.insert(it, { time, pin, state });
+}
+
+void Simulator::dispatchScheduledInputs(double time) {
+    double currentTime = _time;
+    auto it = _scheduledInputs.begin();
+    while (it != _scheduledInputs.end() && it->time <= time) {
+        _time = it->time;
+        writeDigitalInput(it->pin, it->state);
+        ++it;
+    }
+    _scheduledInputs.erase(_scheduledInputs.begin(), it);
+    _time = currentTime;
+}
+
 void Simulator::sendMidi(int port, const MidiMessage &message) {
     writeMidiInput(MidiEvent::makeMessage(port, message));
 }
@@ -103,6 +122,10 @@ void Simulator::registerTargetOutputObserver(TargetOutputHandler *observer) {
     _targetOutputObservers.emplace_back(observer);
 }
 
+void Simulator::unregisterTargetOutputObserver(TargetOutputHandler *observer) {
+    _targetOutputObservers.erase(std::remove(_targetOutputObservers.begin(), _targetOutputObservers.end(), observer), _targetOutputObservers.end());
+}
+
 // TargetInputHandler
 
 void Simulator::writeButton(int index, bool pressed) {
@@ -183,6 +206,8 @@ void Simulator::step() {
         _targetCreated = true;
     }
 
+    _time = _tick;
+
     for (auto observer : _targetTickObservers) {
         observer->setTick(_tick);
     }
@@ -195,6 +220,8 @@ void Simulator::step() {
         callback();
     }
 
+    dispatchScheduledInputs(_tick);
+
     _target.update();
 
     _tick += 1;
@@ -24,6 +24,8 @@ public:
     void rotateEncoder(int direction);
     void setAdc(int channel, float voltage);
     void setDio(int pin, bool state);
+    // schedule a digital input change at the given time in milliseconds (sub-millisecond precision)
+    void scheduleDio(double time, int pin, bool state);
     void sendMidi(int port, const MidiMessage &message);
 
     void screenshot(const std::string &filename);
@@ -32,6 +34,14 @@ public:
 
     double ticks();
 
+    // current time in milliseconds, drivers dispatching timed events set this to the
+    // exact (sub-millisecond) time of the event being dispatched
+    double time() const { return _time; }
+    void setTime(double time) { _time = time; }
+
+    // dispatch scheduled inputs up to the given time, called by drivers dispatching timed events
+    void dispatchScheduledInputs(double time);
+
     typedef std::function<void()> UpdateCallback;
 
     void addUpdateCallback(UpdateCallback callback);
@@ -41,6 +51,7 @@ public:
     void registerTargetTickObserver(TargetTickHandler *observer);
     void registerTargetInputObserver(TargetInputHandler *observer);
     void registerTargetOutputObserver(TargetOutputHandler *observer);
+    void unregisterTargetOutputObserver(TargetOutputHandler *observer);
 
     // TargetInputHandler
     void writeButton(int index, bool pressed) override;
@@ -66,6 +77,7 @@ private:
     bool _targetCreated = false;
 
     uint32_t _tick = 0;
+    double _time = 0.0;
 
     std::vector<TargetTickHandler *> _targetTickObservers;
     std::vector<TargetInputHandler *> _targetInputObservers;
@@ -73,6 +85,14 @@ private:
 
     std::vector<UpdateCallback> _updateCallbacks;
 
+    struct ScheduledInput {
+        double time;
+        int pin;
+        bool state;
+    };
+
+    std::vector<ScheduledInput> _scheduledInputs;
+
     TargetState _targetState;
     TargetStateTracker _targetStateTracker;
 };
@@ -0,0 +1,43 @@
+#include "TargetEdgeRecorder.h"
+
+namespace sim {
+
+TargetEdgeRecorder::TargetEdgeRecorder(Simulator &simulator) :
+    _simulator(simulator)
+{
+    _simulator.registerTargetOutputObserver(this);
+}
+
+TargetEdgeRecorder::~TargetEdgeRecorder() {
+    _simulator.unregisterTargetOutputObserver(this);
+}
+
+void TargetEdgeRecorder::clear() {
+    _gateOutput.clear();
+    _digitalOutput.clear();
+    _midiOutput.clear();
+}
+
+// TargetOutputHandler
+
+void TargetEdgeRecorder::writeGateOutput(int channel, bool value) {
+    if (channel >= 0 && channel < GateOutputState::Count && _gateOutputState.state[channel] != value) {
+        _gateOutputState.set(channel, value);
+        _gateOutput.push_back({ _simulator.time(), channel, value });
+    }
+}
+
+void TargetEdgeRecorder::writeDigitalOutput(int pin, bool value) {
+    if (pin >= 0 && pin < DigitalOutputState::Count && _digitalOutputState.state[pin] != value) {
+        _digitalOutputState.set(pin, value);
+        _digitalOutput.push_back({ _simulator.time(), pin, value });
+    }
+}
+
+void TargetEdgeRecorder::writeMidiOutput(MidiEvent event) {
+    if (event.kind == MidiEvent::Message) {
+        _midiOutput.push_back({ _simulator.time(), event.port, event.message });
+    }
+}
+
+} // namespace sim
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Simulator.h"
+#include "TargetState.h"
+
+#include <vector>
+
+namespace sim {
+
+// Records gate and digital output edges as well as MIDI output messages with sub-millisecond
+// timestamps (see Simulator::time()).
+class TargetEdgeRecorder : public TargetOutputHandler {
+public:
+    struct Edge {
+        double time;
+        int channel;
+        bool value;
+    };
+
+    struct Midi {
+        double time;
+        int port;
+        MidiMessage message;
+    };
+
+    TargetEdgeRecorder(Simulator &simulator);
+    virtual ~TargetEdgeRecorder();
+
+    const std::vector<Edge> &gateOutput() const { return _gateOutput; }
+    const std::vector<Edge> &digitalOutput() const { return _digitalOutput; }
+    const std::vector<Midi> &midiOutput() const { return _midiOutput; }
+
+    void clear();
+
+    // TargetOutputHandler
+    virtual void writeGateOutput(int channel, bool value) override;
+    virtual void writeDigitalOutput(int pin, bool value) override;
+    virtual void writeMidiOutput(MidiEvent event) override;
+
+private:
+    Simulator &_simulator;
+
+    GateOutputState _gateOutputState;
+    DigitalOutputState _digitalOutputState;
+
+    std::vector<Edge> _gateOutput;
+    std::vector<Edge> _digitalOutput;
+    std::vector<Midi> _midiOutput;
+};
+
+} // namespace sim
@@ -0,0 +1,111 @@
+#include "TargetEventWriter.h"
+#include "TargetUtils.h"
+
+#include "tinyformat.h"
+
+#include <cmath>
+
+namespace sim {
+
+static const char *typeName(TargetEventWriter::Type type) {
+    switch (type) {
+    case TargetEventWriter::Type::Gate:     return "gate";
+    case TargetEventWriter::Type::Cv:       return "cv";
+    case TargetEventWriter::Type::Digital:  return "digital";
+    case TargetEventWriter::Type::Midi:     return "midi";
+    case TargetEventWriter::Type::UsbMidi:  return "usbmidi";
+    }
+    return nullptr;
+}
+
+TargetEventWriter::TargetEventWriter(Simulator &simulator, std::ostream &os, Format format) :
+    _simulator(simulator),
+    _os(os),
+    _format(format)
+{
+    if (_format == Format::Csv) {
+        _os << "time,type,channel,value\n";
+    }
+
+    _simulator.registerTargetOutputObserver(this);
+}
+
+TargetEventWriter::~TargetEventWriter() {
+    _simulator.unregisterTargetOutputObserver(this);
+    _os.flush();
+}
+
+// TargetOutputHandler
+
+void TargetEventWriter::writeGateOutput(int channel, bool value) {
+    if (channel >= 0 && channel < GateOutputState::Count && _gateOutputState.state[channel] != value) {
+        _gateOutputState.set(channel, value);
+        write(Type::Gate, channel, value);
+    }
+}
+
+void TargetEventWriter::writeDac(int channel, uint16_t value) {
+    if (channel >= 0 && channel < DacState::Count && (!_dacValid[channel] || _dacState.state[channel] != value)) {
+        _dacState.set(channel, value);
+        _dacValid[channel] = true;
+        write(Type::Cv, channel, value);
+    }
+}
+
+void TargetEventWriter::writeDigitalOutput(int pin, bool value) {
+    if (pin >= 0 && pin < DigitalOutputState::Count && _digitalOutputState.state[pin] != value) {
+        _digitalOutputState.set(pin, value);
+        write(Type::Digital, pin, value);
+    }
+}
+
+void TargetEventWriter::writeMidiOutput(MidiEvent event) {
+    if (event.kind == MidiEvent::Message) {
+        writeMidi(event.port, event.message);
+    }
+}
+
+void TargetEventWriter::write(Type type, int channel, uint16_t value) {
+    switch (_format) {
+    case Format::Csv:
+        if (type == Type::Cv) {
+            _os << tfm::format("%u,%s,%d,%.4f\n", time(), typeName(type), channel, dacToVoltage(value));
+        } else {
+            _os << tfm::format("%u,%s,%d,%d\n", time(), typeName(type), channel, value);
+        }
+        break;
+    case Format::Binary: {
+        Record record = { time(), type, uint8_t(channel), value };
+        _os.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        break;
+    }
+    }
+    ++_events;
+}
+
+void TargetEventWriter::writeMidi(int port, const MidiMessage &message) {
+    Type type = port == 0 ? Type::Midi : Type::UsbMidi;
+
+    switch (_format) {
+    case Format::Csv: {
+        _os << tfm::format("%u,%s,%d,", time(), typeName(type), port);
+        for (int i = 0; i < message.length(); ++i) {
+            _os << tfm::format(i == 0 ? "%02x" : " %02x", message.raw()[i]);
+        }
+        _os << "\n";
+        break;
+    }
+    case Format::Binary: {
+        Record record = { time(), type, message.status(), uint16_t(message.data0() | (message.data1() << 8)) };
+        _os.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        break;
+    }
+    }
+    ++_events;
+}
+
+uint32_t TargetEventWriter::time() const {
+    return uint32_t(std::round(_simulator.time() * 1000.0));
+}
+
+} // namespace sim
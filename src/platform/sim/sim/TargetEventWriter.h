@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Simulator.h"
+#include "TargetState.h"
+
+#include <ostream>
+
+#include <cstdint>
+
+namespace sim {
+
+// Streams timestamped output events (gate, cv, digital outputs and midi messages) to a stream.
+// Only changes of output state are written. Timestamps are in microseconds (see Simulator::time()).
+//
+// CSV format has one event per line: time,type,channel,value
+// - gate/digital: value is 0 or 1
+// - cv: value is the output voltage
+// - midi/usbmidi: channel is the midi port, value is the message as hex bytes
+//
+// Binary format is a sequence of little endian 8 byte records (see Record).
+class TargetEventWriter : public TargetOutputHandler {
+public:
+    enum class Format {
+        Csv,
+        Binary,
+    };
+
+    enum class Type : uint8_t {
+        Gate    = 0,
+        Cv      = 1,
+        Digital = 2,
+        Midi    = 3,
+        UsbMidi = 4,
+    };
+
+    // Midi records store the status byte in channel and both data bytes in value.
+    struct Record {
+        uint32_t time;
+        Type type;
+        uint8_t channel;
+        uint16_t value;
+    } __attribute__((packed));
+
+    TargetEventWriter(Simulator &simulator, std::ostream &os, Format format);
+    virtual ~TargetEventWriter();
+
+    uint32_t events() const { return _events; }
+
+    // TargetOutputHandler
+    virtual void writeGateOutput(int channel, bool value) override;
+    virtual void writeDac(int channel, uint16_t value) override;
+    virtual void writeDigitalOutput(int pin, bool value) override;
+    virtual void writeMidiOutput(MidiEvent event) override;
+
+private:
+    void write(Type type, int channel, uint16_t value);
+    void writeMidi(int port, const MidiMessage &message);
+
+    uint32_t time() const;
+
+    Simulator &_simulator;
+    std::ostream &_os;
+    Format _format;
+    uint32_t _events = 0;
+
+    GateOutputState _gateOutputState;
+    DacState _dacState;
+    DigitalOutputState _digitalOutputState;
+    bool _dacValid[DacState::Count] = {};
+};
+
+} // namespace sim
@@ -42,7 +42,7 @@ void ButtonLedMatrix::process() {
             int buttonIndex = col * Rows + scanRow;
             auto &state = _buttonState[buttonIndex].state;
             bool newState = !(buttonData & (1 << col));
-            if (newState != state) {
+            if (newState != state && !_events.full()) {
                 state = newState;
                 _events.write(Event(state ? Event::KeyDown : Event::KeyUp, buttonIndex));
             }
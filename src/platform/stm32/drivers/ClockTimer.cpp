@@ -1,4 +1,5 @@
 #include "ClockTimer.h"
+#include "HighResolutionTimer.h"
 
 #include "SystemConfig.h"
 
@@ -15,6 +16,7 @@
 #define TIMER TIM5
 
 static ClockTimer::Listener *g_listener;
+static volatile uint32_t g_tickTime;
 
 void ClockTimer::init() {
     rcc_periph_clock_enable(RCC_TIM5);
@@ -52,6 +54,10 @@ void ClockTimer::setPeriod(uint32_t us) {
     timer_set_counter(TIMER, std::min(timer_get_counter(TIMER), us - 1));
 }
 
+uint32_t ClockTimer::tickTime() const {
+    return g_tickTime;
+}
+
 void ClockTimer::setListener(Listener *listener) {
     os::InterruptLock lock;
     g_listener = listener;
@@ -60,6 +66,7 @@ void ClockTimer::setListener(Listener *listener) {
 void tim5_isr() {
     if (timer_get_flag(TIM5, TIM_SR_UIF)) {
         timer_clear_flag(TIM5, TIM_SR_UIF);
+        g_tickTime = HighResolutionTimer::us();
         if (g_listener) {
             g_listener->onClockTimerTick();
         }
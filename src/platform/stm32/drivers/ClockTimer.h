@@ -17,6 +17,9 @@ public:
     uint32_t period() const { return _period; }
     void setPeriod(uint32_t us);
 
+    // time of the last timer tick in microseconds (HighResolutionTimer time base)
+    uint32_t tickTime() const;
+
     void setListener(Listener *listener);
 
 private:
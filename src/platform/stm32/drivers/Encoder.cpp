@@ -45,7 +45,7 @@ void Encoder::process() {
     bool switchState = _switchDebouncer.debounce(!gpio_get(ENC_PORT, ENC_SWITCH));
     if (switchState != _switchState) {
         _switchState = switchState;
-        _events.write(switchState ? Event::Down : Event::Up);
+        writeEvent(switchState ? Event::Down : Event::Up);
     }
 
     uint8_t encoderBits =
@@ -55,9 +55,9 @@ void Encoder::process() {
     _encoderState = encoderStateTable[_encoderState][encoderBits];
 
     if (_encoderState & CW) {
-        _events.write(_reverse ? Event::Right : Event::Left);
+        writeEvent(_reverse ? Event::Right : Event::Left);
     } else if (_encoderState & CCW) {
-        _events.write(_reverse ? Event::Left : Event::Right);
+        writeEvent(_reverse ? Event::Left : Event::Right);
     }
 
     _encoderState &= 0xf;
@@ -31,6 +31,13 @@ public:
     }
 
 private:
+    inline void writeEvent(Event event) {
+        // drop events if the consumer does not keep up
+        if (!_events.full()) {
+            _events.write(event);
+        }
+    }
+
     bool _reverse;
 
     RingBuffer<uint8_t, 32> _events;
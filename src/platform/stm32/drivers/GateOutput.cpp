@@ -10,3 +10,8 @@ void GateOutput::init() {
 void GateOutput::update() {
     _shiftRegister.write(2, _gates);
 }
+
+void GateOutput::write(uint8_t gates) {
+    _shiftRegister.write(2, gates);
+    _shiftRegister.flush();
+}
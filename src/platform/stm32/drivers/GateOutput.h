@@ -12,6 +12,9 @@ public:
 
     void update();
 
+    // write gates to the hardware immediately, bypassing the staged gates (interrupt safe)
+    void write(uint8_t gates);
+
     inline uint8_t gates() const { return _gates; }
 
     inline void setGates(uint8_t gates) {
@@ -1,9 +1,12 @@
 #include "Lcd.h"
 
 #include "core/Debug.h"
+#include "core/profiler/Profiler.h"
 
 #include "hal/Delay.h"
 
+#include "os/os.h"
+
 #include <libopencm3/cm3/nvic.h>
 #include <libopencm3/stm32/gpio.h>
 #include <libopencm3/stm32/rcc.h>
@@ -65,8 +68,12 @@ static InitCommand initCommands[] = {
     { 0x00 }
 };
 
+PROFILER_COUNTER(lcdSkippedFrames, "LCD SKIP")
+PROFILER_COUNTER(lcdDroppedFrames, "LCD DROP")
+
 #ifdef LCD_USE_DMA
-static volatile uint32_t txDone = 1;
+// given by the dma interrupt when the transfer has completed
+static os::Semaphore txDone;
 #endif // LCD_USE_DMA
 
 static inline void waitTxDone() {
@@ -103,6 +110,7 @@ void Lcd::init() {
     dma_stream_reset(LCD_DMA, LCD_DMA_STREAM);
     nvic_set_priority(NVIC_DMA1_STREAM4_IRQ, CONFIG_LCD_IRQ_PRIORITY);
     nvic_enable_irq(NVIC_DMA1_STREAM4_IRQ);
+    txDone.give();
 #endif // LCD_USE_DMA
 
     // init control pins
@@ -123,37 +131,75 @@ void Lcd::init() {
     initialize();
 }
 
-void Lcd::draw(uint8_t *frameBuffer) {
+void Lcd::draw(const uint8_t *frameBuffer, int top, int bottom) {
+    // display ram content is unknown until the first full frame was sent
+    if (!_frameBufferValid) {
+        top = 0;
+        bottom = Height - 1;
+    }
+
+    // include rows of dropped frames
+    top = std::min(top, _pendingTop);
+    bottom = std::max(bottom, _pendingBottom);
+
 #ifdef LCD_USE_DMA
-    // wait until previous frame is sent
-    while (!txDone) {}
-    txDone = 0;
+    // previous frame is still transferred from the frame buffer
+    if (!txDone.take(0)) {
+        _pendingTop = top;
+        _pendingBottom = bottom;
+        ++_droppedFrames;
+        PROFILER_COUNTER_ADD(lcdDroppedFrames, 1)
+        return;
+    }
 #endif // LCD_USE_DMA
 
-    // copy buffer
-    uint8_t *src = frameBuffer;
-    uint8_t *dst = reinterpret_cast<uint8_t *>(_frameBuffer);
-    for (int i = 0; i < Width * Height / 2; ++i) {
-        uint8_t a = *src++;
-        uint8_t b = *src++;
-        *dst++ = std::min(b, uint8_t(15)) | (std::min(a, uint8_t(15)) << 4);
-        // *dst++ = (b >> 4) | ((a >> 4) << 4);
+    _pendingTop = Height;
+    _pendingBottom = -1;
+
+    // copy rows and find the window of changed rows
+    const uint32_t *words = reinterpret_cast<const uint32_t *>(frameBuffer);
+    int first = Height;
+    int last = -1;
+    for (int y = top; y <= bottom; ++y) {
+        const uint32_t *src = &words[y * RowWords];
+        uint32_t *dst = &_frameBuffer[y * RowWords];
+        uint32_t changed = 0;
+        for (int i = 0; i < RowWords; ++i) {
+            changed |= src[i] ^ dst[i];
+            dst[i] = src[i];
+        }
+        if (changed || !_frameBufferValid) {
+            first = std::min(first, y);
+            last = y;
+        }
     }
 
-
+    if (last < first) {
 #ifdef LCD_USE_DMA
+        txDone.give();
+#endif // LCD_USE_DMA
+        PROFILER_COUNTER_ADD(lcdSkippedFrames, 1)
+        return;
+    }
+
+    _frameBufferValid = true;
 
     setColAddr(0x1c,0x5b);
-    setRowAddr(0x00,0x3f);
+    setRowAddr(first, last);
     setWrite();
 
+    uint8_t *src = reinterpret_cast<uint8_t *>(&_frameBuffer[first * RowWords]);
+    size_t length = (last - first + 1) * Width / 2;
+
+#ifdef LCD_USE_DMA
+
     waitTxDone();
     gpio_set(LCD_PORT, LCD_DC);
 
     dma_stream_reset(LCD_DMA, LCD_DMA_STREAM);
     dma_set_peripheral_address(LCD_DMA, LCD_DMA_STREAM, reinterpret_cast<uint32_t>(&LCD_SPI_DR));
-    dma_set_memory_address(LCD_DMA, LCD_DMA_STREAM, reinterpret_cast<uint32_t>(_frameBuffer));
-    dma_set_number_of_data(LCD_DMA, LCD_DMA_STREAM, sizeof(_frameBuffer));
+    dma_set_memory_address(LCD_DMA, LCD_DMA_STREAM, reinterpret_cast<uint32_t>(src));
+    dma_set_number_of_data(LCD_DMA, LCD_DMA_STREAM, length);
     dma_channel_select(LCD_DMA, LCD_DMA_STREAM, LCD_DMA_CHANNEL);
     dma_set_priority(LCD_DMA, LCD_DMA_STREAM, DMA_SxCR_PL_HIGH);
 
@@ -172,20 +218,21 @@ void Lcd::draw(uint8_t *frameBuffer) {
 
 #else // LCD_USE_DMA
 
-    setColAddr(0x1c,0x5b);
-    setRowAddr(0x00,0x3f);
-    setWrite();
-
-    src = reinterpret_cast<uint8_t *>(_frameBuffer);
-    for (int y = 0; y < Height; y++) {
-        for (int x = 0; x < Width/2; x++) {
-            sendData(*src++);
-        }
+    for (size_t i = 0; i < length; ++i) {
+        sendData(*src++);
     }
 
 #endif // LCD_USE_DMA
 }
 
+void Lcd::flush() {
+#ifdef LCD_USE_DMA
+    if (txDone.take(os::time::ms(100))) {
+        txDone.give();
+    }
+#endif // LCD_USE_DMA
+}
+
 void Lcd::sendCmd(uint8_t cmd) {
     waitTxDone();
     gpio_clear(LCD_PORT, LCD_DC);
@@ -238,7 +285,7 @@ void dma1_stream4_isr(void) {
 
         waitTxDone();
 
-        txDone = 1;
+        os::isr::exit(txDone.giveFromISR());
     }
 }
 #endif // LCD_USE_DMA
@@ -12,7 +12,18 @@ public:
 
     void init();
 
-    void draw(uint8_t *frameBuffer);
+    // Copies rows [top, bottom] of the packed 4 bit frame buffer (word aligned) into the transfer buffer and starts
+    // the transfer of the rows that changed. If the previous transfer has not completed yet, the frame is dropped and
+    // its rows are sent with the next frame.
+    void draw(const uint8_t *frameBuffer, int top = 0, int bottom = Height - 1);
+
+    // waits until the current transfer has completed
+    void flush();
+
+    // returns true if rows of a dropped frame still need to be sent
+    bool hasPending() const { return _pendingTop <= _pendingBottom; }
+
+    uint32_t droppedFrames() const { return _droppedFrames; }
 
 private:
     void sendCmd(uint8_t cmd);
@@ -24,5 +35,14 @@ private:
     void setRowAddr(uint8_t a, uint8_t b);
     void setWrite();
 
+    static constexpr int RowWords = Width / 8;
+
+    // transfer buffer (dma cannot access the ui frame buffer in ccm ram), only written while no transfer is running,
+    // so it always holds the display content
     uint32_t _frameBuffer[Width * Height / 8];
+    bool _frameBufferValid = false;
+    // rows of dropped frames
+    int _pendingTop = Height;
+    int _pendingBottom = -1;
+    uint32_t _droppedFrames = 0;
 };
@@ -38,11 +38,28 @@ void Midi::init() {
 }
 
 bool Midi::send(const MidiMessage &message) {
-    for (uint8_t i = 0; i < message.length(); ++i) {
-        send(message.raw()[i]);
+    os::InterruptLock lock;
+
+    // block until there is space in the tx queue, continuous controllers are coalesced or dropped instead
+    if (!MidiTxQueue<TxQueueSize>::isContinuous(message)) {
+        while (_txQueue.full()) {
+            uint8_t data;
+            _txQueue.nextByte(data);
+            usart_wait_send_ready(MIDI_USART);
+            usart_send(MIDI_USART, data);
+        }
     }
 
-    return true;
+    bool result = _txQueue.push(message);
+    startTx();
+    return result;
+}
+
+bool Midi::sendRealTime(uint8_t data) {
+    os::InterruptLock lock;
+    bool result = _txQueue.pushRealTime(data);
+    startTx();
+    return result;
 }
 
 bool Midi::recv(MidiMessage *message) {
@@ -59,22 +76,13 @@ void Midi::setRecvFilter(RecvFilter filter) {
     _recvFilter = filter;
 }
 
-void Midi::send(uint8_t data) {
-    os::InterruptLock lock;
-
-    // block until there is space in the tx buffer
-    while (_txBuffer.full()) {
-        usart_wait_send_ready(MIDI_USART);
-        usart_send(MIDI_USART, _txBuffer.read());
-    }
-
-    _txBuffer.write(data);
-
+void Midi::startTx() {
     // start transmission if necessary
-    if (!_txActive) {
+    uint8_t data;
+    if (!_txActive && _txQueue.nextByte(data)) {
         _txActive = 1;
         usart_wait_send_ready(MIDI_USART);
-        usart_send(MIDI_USART, _txBuffer.read());
+        usart_send(MIDI_USART, data);
         usart_enable_tx_interrupt(MIDI_USART);
     }
 }
@@ -82,11 +90,14 @@ void Midi::send(uint8_t data) {
 void Midi::handleIrq() {
     os::InterruptLock lock;
     if (usart_get_flag(MIDI_USART, USART_SR_TXE)) {
-        if (_txBuffer.empty()) {
+        uint8_t data;
+        if (_txQueue.nextByte(data)) {
+            usart_send(MIDI_USART, data);
+        } else {
             usart_disable_tx_interrupt(MIDI_USART);
             _txActive = 0;
-        } else {
-            usart_send(MIDI_USART, _txBuffer.read());
+            // resend status after idle times to let receivers resynchronize
+            _txQueue.resetRunningStatus();
         }
     }
     if (usart_get_flag(MIDI_USART, USART_SR_RXNE)) {
@@ -95,8 +106,9 @@ void Midi::handleIrq() {
             if (_rxBuffer.full()) {
                 // overflow
                 ++_rxOverflow;
+            } else {
+                _rxBuffer.write(data);
             }
-            _rxBuffer.write(data);
         }
     }
 }
@@ -2,6 +2,7 @@
 
 #include "core/midi/MidiMessage.h"
 #include "core/midi/MidiParser.h"
+#include "core/midi/MidiTxQueue.h"
 #include "core/utils/RingBuffer.h"
 
 #include <functional>
@@ -15,17 +16,23 @@ public:
     void init();
 
     bool send(const MidiMessage &message);
+    // sends a single byte real-time message ahead of queued messages
+    bool sendRealTime(uint8_t data);
     bool recv(MidiMessage *message);
 
     void setRecvFilter(RecvFilter filter);
 
     uint32_t rxOverflow() const { return _rxOverflow; }
+    uint32_t txBytesSaved() const { return _txQueue.stats().bytesSaved; }
+    uint32_t txDrops() const { return _txQueue.stats().drops; }
 
     void handleIrq();
 private:
-    void send(uint8_t data);
+    void startTx();
 
-    RingBuffer<uint8_t, 64> _txBuffer;
+    static constexpr size_t TxQueueSize = 32;
+
+    MidiTxQueue<TxQueueSize> _txQueue;
     RingBuffer<uint8_t, 64> _rxBuffer;
     volatile uint32_t _rxOverflow = 0;
     volatile uint32_t _txActive = 0;
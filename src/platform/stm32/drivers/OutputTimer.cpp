@@ -0,0 +1,90 @@
+#include "OutputTimer.h"
+#include "HighResolutionTimer.h"
+
+#include "SystemConfig.h"
+
+#include "os/os.h"
+
+#include <libopencm3/stm32/rcc.h>
+#include <libopencm3/stm32/timer.h>
+#include <libopencm3/cm3/nvic.h>
+
+#include <algorithm>
+
+#define TIMER TIM3
+
+static OutputTimer *g_timer;
+static OutputTimer::Listener *g_listener;
+
+void OutputTimer::init() {
+    g_timer = this;
+
+    rcc_periph_clock_enable(RCC_TIM3);
+    nvic_set_priority(NVIC_TIM3_IRQ, CONFIG_OUTPUTTIMER_IRQ_PRIORITY);
+    nvic_enable_irq(NVIC_TIM3_IRQ);
+    rcc_periph_reset_pulse(RST_TIM3);
+
+    timer_disable_preload(TIMER);
+    timer_one_shot_mode(TIMER);
+
+    // set to 1mhz
+    uint32_t prescaler = (rcc_apb1_frequency * 2) / 1000000 - 1;
+    timer_set_prescaler(TIMER, prescaler);
+
+    timer_enable_update_event(TIMER);
+    timer_enable_irq(TIMER, TIM_DIER_UIE);
+}
+
+uint32_t OutputTimer::now() const {
+    return HighResolutionTimer::us();
+}
+
+void OutputTimer::schedule(uint32_t time) {
+    os::InterruptLock lock;
+    _time = time;
+    _pending = true;
+    arm();
+}
+
+void OutputTimer::cancel() {
+    os::InterruptLock lock;
+    _pending = false;
+    timer_disable_counter(TIMER);
+}
+
+void OutputTimer::setListener(Listener *listener) {
+    os::InterruptLock lock;
+    g_listener = listener;
+}
+
+void OutputTimer::arm() {
+    // TIM3 is a 16-bit timer, longer delays are split into multiple runs
+    int32_t delay = std::max(int32_t(_time - now()), int32_t(1));
+    timer_disable_counter(TIMER);
+    timer_set_period(TIMER, std::min(delay, int32_t(0xffff)));
+    timer_set_counter(TIMER, 0);
+    timer_enable_counter(TIMER);
+}
+
+void OutputTimer::interrupt() {
+    if (!_pending) {
+        return;
+    }
+    if (int32_t(_time - now()) > 0) {
+        arm();
+    } else {
+        _pending = false;
+        if (g_listener) {
+            g_listener->onOutputTimer();
+        }
+    }
+}
+
+void tim3_isr() {
+    if (timer_get_flag(TIM3, TIM_SR_UIF)) {
+        timer_clear_flag(TIM3, TIM_SR_UIF);
+        if (g_timer) {
+            g_timer->interrupt();
+        }
+    }
+}
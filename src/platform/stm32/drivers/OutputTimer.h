@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+// One-shot hardware timer used to apply output events at exact points in time.
+// Time is measured in microseconds using the same time base as HighResolutionTimer.
+class OutputTimer {
+public:
+    struct Listener {
+        virtual void onOutputTimer() = 0;
+    };
+
+    void init();
+
+    uint32_t now() const;
+
+    // request a single listener callback at the given time (replaces any pending request)
+    void schedule(uint32_t time);
+    void cancel();
+
+    void setListener(Listener *listener);
+
+    // called from timer interrupt
+    void interrupt();
+
+private:
+    void arm();
+
+    volatile uint32_t _time = 0;
+    volatile bool _pending = false;
+};
@@ -5,6 +5,8 @@
 #include "core/profiler/Profiler.h"
 #include "core/Debug.h"
 
+#include "os/os.h"
+
 #include <libopencm3/stm32/gpio.h>
 #include <libopencm3/stm32/rcc.h>
 #include <libopencm3/stm32/spi.h>
@@ -66,6 +68,9 @@ void ShiftRegister::init() {
 }
 
 void ShiftRegister::process() {
+    // transfer with interrupts enabled, flush() from interrupt context is deferred while busy
+    _busy = true;
+
     // trigger load line
     gpio_clear(SR_PORT, SR_LOAD);
     gpio_set(SR_PORT, SR_LOAD);
@@ -78,4 +83,36 @@ void ShiftRegister::process() {
     // trigger latch line
     gpio_set(SR_PORT, SR_LATCH);
     gpio_clear(SR_PORT, SR_LATCH);
+
+    // send outputs again if a flush was deferred during the transfer
+    while (true) {
+        {
+            os::InterruptLock lock;
+            if (!_flushPending) {
+                _busy = false;
+                break;
+            }
+            _flushPending = false;
+        }
+        shiftOut();
+    }
+}
+
+void ShiftRegister::flush() {
+    if (_busy) {
+        _flushPending = true;
+        return;
+    }
+    shiftOut();
+}
+
+void ShiftRegister::shiftOut() {
+    // transfer data
+    for (int sr = 0; sr < NumRegisters; ++sr) {
+        spi_xfer(SR_SPI, _outputs[NumRegisters - sr - 1]);
+    }
+
+    // trigger latch line
+    gpio_set(SR_PORT, SR_LATCH);
+    gpio_clear(SR_PORT, SR_LATCH);
 }
@@ -16,10 +16,18 @@ public:
 
     void process();
 
+    // shift out and latch outputs immediately without reading inputs, must be called from interrupt context
+    // or with interrupts disabled. If process() is transferring, the outputs are sent once it is done.
+    void flush();
+
     uint8_t read(int index) const { return _inputs[index]; }
     void write(int index, uint8_t value) { _outputs[index] = value; }
 
 private:
+    void shiftOut();
+
     std::array<uint8_t, NumRegisters> _outputs;
     std::array<uint8_t, NumRegisters> _inputs;
+    volatile bool _busy = false;
+    volatile bool _flushPending = false;
 };
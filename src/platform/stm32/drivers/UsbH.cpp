@@ -5,6 +5,7 @@
 
 #include "core/Debug.h"
 #include "core/midi/MidiMessage.h"
+#include "core/midi/UsbMidiPacketWriter.h"
 
 #include "usbh_core.h"				/// provides usbh_init() and usbh_poll()
 #include "usbh_lld_stm32f4.h"		/// provides low level usb host driver for stm32f4 platform
@@ -42,23 +43,27 @@ static const usbh_low_level_driver_t * const lld_drivers[] = {
 	nullptr
 };
 
+static_assert(UsbMidi::MaxDevices >= USBH_AC_MIDI_MAX_DEVICES, "not enough device stats");
+
+// a full speed bulk transfer holds up to 16 USB-MIDI events
 static constexpr size_t WriteBufferSize = 64;
-static uint8_t writeBuffer[2][WriteBufferSize];
-static size_t writeBufferSize;
-static size_t writeBufferIndex;
-static size_t writeBufferPos;
+static UsbMidiPacketWriter<WriteBufferSize> packetWriter;
+static bool writePending;
 
 struct MidiDriverHandler {
 
     static void connectHandler(int device, uint16_t vendorId, uint16_t productId, uint32_t maxPacketSize) {
         DBG("MIDI device connected (id=%d, vendorId=%04x, productId=%04x, maxPacketSize=%ld)", device, vendorId, productId, maxPacketSize);
         g_usbh->midiConnectDevice(device, vendorId, productId);
-        writeBufferSize = std::min(WriteBufferSize, size_t(maxPacketSize));
+        packetWriter.setMaxSize(maxPacketSize);
+        writePending = false;
     }
 
     static void disconnectHandler(int device) {
         DBG("MIDI device disconnected (id=%d)", device);
         g_usbh->midiDisconnectDevice(device);
+        packetWriter.reset();
+        writePending = false;
     }
 
     static void recvHandler(int device, uint8_t *data) {
@@ -99,86 +104,27 @@ struct MidiDriverHandler {
         }
     }
 
-    static bool write(uint8_t device, uint8_t cable, const MidiMessage &message) {
-        bool flushed = true;
-
-        if (message.isSystemExclusive()) {
-            const uint8_t *payloadData = message.payloadData();
-            size_t payloadLength = message.payloadLength();
-            if (payloadData && payloadLength > 0) {
-                size_t messageLength = payloadLength + 2;
-                size_t writeSize = ((messageLength + 3) / 4) * 4;
-                if (writeBufferPos + writeSize >= writeBufferSize) {
-                    flush(device);
-                    flushed = true;
-                }
-
-                size_t messageIndex = 0;
-                while (messageIndex < messageLength) {
-                    uint8_t *p = &writeBuffer[writeBufferIndex][writeBufferPos];
-                    size_t chunkSize;
-                    switch (messageLength - messageIndex) {
-                    case 1:
-                        p[0] = 0x5;
-                        chunkSize = 1;
-                        break;
-                    case 2:
-                        p[0] = 0x6;
-                        chunkSize = 2;
-                        break;
-                    case 3:
-                        p[0] = 0x7;
-                        chunkSize = 3;
-                        break;
-                    default:
-                        p[0] = 0x4;
-                        chunkSize = 3;
-                        break;
-                    }
-                    p[0] |= cable << 4;
-                    for (size_t i = 0; i < chunkSize; ++i) {
-                        uint8_t byte;
-                        if (messageIndex == 0) {
-                            byte = 0xf0;
-                        } else if (messageIndex == messageLength - 1) {
-                            byte = 0xf7;
-                        } else {
-                            byte = payloadData[messageIndex - 1];
-                        }
-                        p[1 + i] = byte;
-                        ++messageIndex;
-                    }
-                    for (size_t i = chunkSize; i < 3; ++i) {
-                        p[1 + i] = 0;
-                    }
-                    writeBufferPos += 4;
-                }
-            }
-        } else {
-            if (writeBufferPos + 4 >= writeBufferSize) {
-                flush(device);
-                flushed = true;
-            }
-            uint8_t *p = &writeBuffer[writeBufferIndex][writeBufferPos];
-            p[0] = message.status() >> 4 | (cable << 4);
-            p[1] = message.status();
-            p[2] = message.data0();
-            p[3] = message.data1();
-            writeBufferPos += 4;
-        }
-
-        return flushed;
-    }
-
     static void flush(uint8_t device) {
-        if (writeBufferPos > 0) {
-            usbh_midi_write(device, writeBuffer[writeBufferIndex], writeBufferPos, &writeCallback);
-            writeBufferIndex = (writeBufferIndex + 1) % 2;
-            writeBufferPos = 0;
+        if (packetWriter.empty()) {
+            return;
+        }
+        size_t events = packetWriter.events();
+        // set before starting the transfer, the callback may be called before usbh_midi_write() returns
+        writePending = true;
+        // the callback is only called if the transfer was started, drop the events if the device is gone
+        if (g_usbh->midiDeviceConnected(device) &&
+            usbh_midi_write(device, packetWriter.data(), packetWriter.size(), &writeCallback)) {
+            g_usbh->midiTransferSent(device, events);
+        } else {
+            writePending = false;
+            packetWriter.reset();
         }
     }
 
     static void writeCallback(uint8_t bytes_written) {
+        // buffer is no longer in use
+        packetWriter.clear();
+        writePending = false;
     }
 };
 
@@ -225,22 +171,22 @@ void UsbH::process() {
 
     usbh_poll(time_us);
 
-    // Start sending MIDI messages
-    uint8_t device;
+    // messages stay queued until the previous transfer has completed
+    if (writePending) {
+        return;
+    }
+
+    // pack as many MIDI messages as fit into a single bulk transfer
+    uint8_t device = 0;
     uint8_t cable;
     MidiMessage message;
-    bool flushed = false;
-    while (midiDequeueMessage(&device, &cable, &message)) {
-        if (midiDeviceConnected(device)) {
-            flushed = MidiDriverHandler::write(device, cable, message);
-            if (flushed) {
-                break;
-            }
+    while (!packetWriter.full() && midiDequeueMessage(&device, &cable, &message)) {
+        if (midiDeviceConnected(device) && !packetWriter.write(cable, message)) {
+            midiRequeueMessage(device, cable, message);
+            break;
         }
     }
-    if (!flushed) {
-        MidiDriverHandler::flush(device);
-    }
+    MidiDriverHandler::flush(device);
 }
 
 void UsbH::powerOn() {
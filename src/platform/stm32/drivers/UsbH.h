@@ -32,21 +32,46 @@ private:
     }
 
     void midiEnqueueMessage(uint8_t device, uint8_t cable, const MidiMessage &message) {
-        _usbMidi.enqueueMessage(cable, message);
+        _usbMidi.enqueueMessage(device, cable, message);
     }
 
     void midiEnqueueData(uint8_t device, uint8_t cable, uint8_t data) {
-        _usbMidi.enqueueData(cable, data);
+        _usbMidi.enqueueData(device, cable, data);
     }
 
     bool midiDequeueMessage(uint8_t *device, uint8_t *cable, MidiMessage *message) {
+        // message that did not fit into the previous transfer
+        if (_midiPending) {
+            _midiPending = false;
+            *device = _midiPendingDevice;
+            *cable = _midiPendingCable;
+            *message = _midiPendingMessage;
+            _midiPendingMessage = MidiMessage();
+            return true;
+        }
         *device = 0;
         return _usbMidi.dequeueMessage(cable, message);
     }
 
+    void midiRequeueMessage(uint8_t device, uint8_t cable, const MidiMessage &message) {
+        _midiPending = true;
+        _midiPendingDevice = device;
+        _midiPendingCable = cable;
+        _midiPendingMessage = message;
+    }
+
+    void midiTransferSent(uint8_t device, size_t events) {
+        _usbMidi.transferSent(device, events);
+    }
+
     UsbMidi &_usbMidi;
 
     uint8_t _midiDevices = 0;
 
+    bool _midiPending = false;
+    uint8_t _midiPendingDevice;
+    uint8_t _midiPendingCable;
+    MidiMessage _midiPendingMessage;
+
     friend struct MidiDriverHandler;
 };
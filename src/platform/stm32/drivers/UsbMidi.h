@@ -13,6 +13,15 @@ public:
     typedef std::function<void()> DisconnectHandler;
     typedef std::function<bool(uint8_t)> RecvFilter;
 
+    static constexpr int MaxDevices = 4;
+
+    struct DeviceStats {
+        uint32_t txEvents;      // USB-MIDI event packets sent
+        uint32_t txTransfers;   // bulk OUT transfers used to send them
+        uint32_t rxEvents;      // USB-MIDI event packets received
+        uint32_t rxOverflow;    // received messages dropped due to a full queue
+    };
+
     void init() {}
 
     bool send(uint8_t cable, const MidiMessage &message) {
@@ -23,6 +32,15 @@ public:
         return true;
     }
 
+    // sends a single byte real-time message ahead of queued messages
+    bool sendRealTime(uint8_t cable, uint8_t data) {
+        if (_realTimeQueue.full()) {
+            return false;
+        }
+        _realTimeQueue.write({ cable, MidiMessage(data) });
+        return true;
+    }
+
     bool recv(uint8_t *cable, MidiMessage *message) {
         if (_rxQueue.empty()) {
             return false;
@@ -45,7 +63,9 @@ public:
         _recvFilter = filter;
     }
 
-    uint32_t rxOverflow() const { return 0; }
+    uint32_t rxOverflow() const { return _rxOverflow; }
+
+    const DeviceStats &deviceStats(int device) const { return _deviceStats[device]; }
 
 private:
     void connect(uint16_t vendorId, uint16_t productId) {
@@ -60,21 +80,32 @@ private:
         }
     }
 
-    void enqueueMessage(uint8_t cable, const MidiMessage &message) {
+    void enqueueMessage(uint8_t device, uint8_t cable, const MidiMessage &message) {
+        auto &stats = _deviceStats[device];
+        ++stats.rxEvents;
         if (_rxQueue.full()) {
             // overflow
             ++_rxOverflow;
+            ++stats.rxOverflow;
+        } else {
+            _rxQueue.write({ cable, message });
         }
-        _rxQueue.write({ cable, message });
     }
 
-    void enqueueData(uint8_t cable, uint8_t data) {
+    void enqueueData(uint8_t device, uint8_t cable, uint8_t data) {
+        ++_deviceStats[device].rxEvents;
         if (_recvFilter && !_recvFilter(data)) {
             // _recvFilter(data);
         }
     }
 
     bool dequeueMessage(uint8_t *cable, MidiMessage *message) {
+        if (!_realTimeQueue.empty()) {
+            auto messageAndCable = _realTimeQueue.read();
+            *cable = messageAndCable.cable;
+            *message = messageAndCable.message;
+            return true;
+        }
         if (_txQueue.empty()) {
             return false;
         }
@@ -84,6 +115,12 @@ private:
         return true;
     }
 
+    void transferSent(uint8_t device, size_t events) {
+        auto &stats = _deviceStats[device];
+        stats.txEvents += events;
+        ++stats.txTransfers;
+    }
+
     ConnectHandler _connectHandler;
     DisconnectHandler _disconnectHandler;
     RecvFilter _recvFilter;
@@ -94,8 +131,10 @@ private:
     };
 
     RingBuffer<CableAndMessage, 128> _txQueue;
+    RingBuffer<CableAndMessage, 8> _realTimeQueue;
     RingBuffer<CableAndMessage, 16> _rxQueue;
     volatile uint32_t _rxOverflow = 0;
+    DeviceStats _deviceStats[MaxDevices] = {};
 
     friend class UsbH;
 };
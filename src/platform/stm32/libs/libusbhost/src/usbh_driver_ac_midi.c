@@ -300,23 +300,23 @@ static void write_callback(usbh_device_t *dev, usbh_packet_callback_data_t statu
 	}
 }
 
-void usbh_midi_write(uint8_t device_id, const void *data, uint32_t length, midi_write_callback_t callback)
+bool usbh_midi_write(uint8_t device_id, const void *data, uint32_t length, midi_write_callback_t callback)
 {
 	// bad device_id handling
 	if (device_id >= USBH_AC_MIDI_MAX_DEVICES) {
-		return;
+		return false;
 	}
 
 	midi_device_t *midi = &midi_device[device_id];
 
 	// device with provided device_id is not alive
 	if (midi->state == 0) {
-		return;
+		return false;
 	}
 
 	usbh_device_t *dev = midi->usbh_device;
 	if (midi->endpoint_out_address == 0) {
-		return;
+		return false;
 	}
 
 	midi->sending = true;
@@ -335,6 +335,7 @@ void usbh_midi_write(uint8_t device_id, const void *data, uint32_t length, midi_
 
 
 	usbh_write(dev, &midi->write_packet);
+	return true;
 }
 
 static void remove(void *drvdata)
@@ -219,6 +219,18 @@ namespace os {
         T _data[Length];
     };
 
+    // Suspends task switching while in scope, interrupts keep being served.
+    class SchedulerLock {
+    public:
+        SchedulerLock() {
+            vTaskSuspendAll();
+        }
+
+        ~SchedulerLock() {
+            xTaskResumeAll();
+        }
+    };
+
     class InterruptLock {
     public:
         InterruptLock() {
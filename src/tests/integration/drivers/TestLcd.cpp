@@ -39,12 +39,13 @@ public:
         canvas.vline(frame % 256, 0, 64);
         canvas.hline(0, frame % 64, 256);
 
-        lcd.draw(frameBuffer.data());
+        lcd.draw(frameBuffer.data(), frameBuffer.dirtyTop(), frameBuffer.dirtyBottom());
+        frameBuffer.clearDirty();
     }
 
 private:
-    uint8_t frameBufferData[256*64];
-    FrameBuffer8bit frameBuffer;
+    uint32_t frameBufferData[256 * 64 / FrameBuffer4bit::PixelsPerWord];
+    FrameBuffer4bit frameBuffer;
     Canvas canvas;
     Lcd lcd;
     Timer timer;
@@ -0,0 +1,199 @@
+#include "UnitTest.h"
+
+#include "core/gfx/Canvas.h"
+
+#include <algorithm>
+
+#include <cstdint>
+
+static constexpr int Width = 256;
+static constexpr int Height = 64;
+
+// per pixel reference renderer
+struct Reference {
+    uint8_t pixels[Width * Height] = {};
+
+    void blend(BlendMode blendMode, int x, int y, uint8_t color) {
+        if (x < 0 || x >= Width || y < 0 || y >= Height) {
+            return;
+        }
+        uint8_t &p = pixels[y * Width + x];
+        switch (blendMode) {
+        case BlendMode::Set: p = color; break;
+        case BlendMode::Add: p = std::min(0xf, p + color); break;
+        case BlendMode::Sub: p = p - std::min(p, color); break;
+        }
+    }
+
+    bool equals(const FrameBuffer4bit &frameBuffer) const {
+        for (int y = 0; y < Height; ++y) {
+            for (int x = 0; x < Width; ++x) {
+                if (frameBuffer.get(x, y) != pixels[y * Width + x]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+static const BlendMode blendModes[] = { BlendMode::Set, BlendMode::Add, BlendMode::Sub };
+
+UNIT_TEST("Canvas") {
+
+    CASE("pixel format") {
+        static uint32_t data[Width * Height / FrameBuffer4bit::PixelsPerWord];
+        float brightness = 1.f;
+        FrameBuffer4bit frameBuffer(Width, Height, data);
+        Canvas canvas(frameBuffer, brightness);
+
+        canvas.setColor(Color::None);
+        canvas.fill();
+        canvas.setColorValue(0xa);
+        canvas.point(0, 0);
+        canvas.setColorValue(0x5);
+        canvas.point(1, 0);
+        canvas.point(255, 63);
+
+        // left pixel is stored in the high nibble
+        expectEqual(frameBuffer.data()[0], uint8_t(0xa5));
+        expectEqual(frameBuffer.data()[Width * Height / 2 - 1], uint8_t(0x05));
+        expectEqual(frameBuffer.get(0, 0), uint8_t(0xa));
+        expectEqual(frameBuffer.get(1, 0), uint8_t(0x5));
+    }
+
+    CASE("blend saturation") {
+        static uint32_t data[Width * Height / FrameBuffer4bit::PixelsPerWord];
+        float brightness = 1.f;
+        FrameBuffer4bit frameBuffer(Width, Height, data);
+        Canvas canvas(frameBuffer, brightness);
+
+        canvas.setColorValue(0xa);
+        canvas.fill();
+        canvas.setBlendMode(BlendMode::Add);
+        canvas.hline(0, 0, Width);
+        expectEqual(frameBuffer.get(0, 0), uint8_t(0xf));
+        expectEqual(frameBuffer.get(100, 0), uint8_t(0xf));
+
+        canvas.setBlendMode(BlendMode::Sub);
+        canvas.setColorValue(0x3);
+        canvas.hline(0, 1, Width);
+        expectEqual(frameBuffer.get(7, 1), uint8_t(0x7));
+        canvas.setColorValue(0xf);
+        canvas.hline(0, 1, Width);
+        expectEqual(frameBuffer.get(8, 1), uint8_t(0x0));
+    }
+
+    CASE("spans and bitmaps match per pixel rendering") {
+        static uint32_t data[Width * Height / FrameBuffer4bit::PixelsPerWord];
+        float brightness = 1.f;
+        FrameBuffer4bit frameBuffer(Width, Height, data);
+        Canvas canvas(frameBuffer, brightness);
+        Reference reference;
+
+        canvas.setColor(Color::None);
+        canvas.fill();
+
+        const uint8_t bitmap[] = { 0xa5, 0x3c, 0xff, 0x81, 0x18, 0x7e, 0x00, 0xc3 };
+
+        uint32_t seed = 1;
+        auto random = [&seed] (int range) {
+            seed = seed * 1103515245 + 12345;
+            return int((seed >> 16) % range);
+        };
+
+        for (int i = 0; i < 500; ++i) {
+            BlendMode blendMode = blendModes[random(3)];
+            uint8_t color = random(16);
+            canvas.setBlendMode(blendMode);
+            canvas.setColorValue(color);
+
+            int x = random(Width + 20) - 10;
+            int y = random(Height);
+            int w = random(40) + 1;
+            int h = random(8) + 1;
+
+            switch (random(3)) {
+            case 0:
+                if (x < 0 || x + w > Width) {
+                    break;
+                }
+                canvas.hline(x, y, w);
+                for (int j = 0; j < w; ++j) {
+                    reference.blend(blendMode, x + j, y, color);
+                }
+                break;
+            case 1:
+                if (x < 0 || x + w > Width || y + h > Height) {
+                    break;
+                }
+                canvas.fillRect(x, y, w, h);
+                for (int v = 0; v < h; ++v) {
+                    for (int u = 0; u < w; ++u) {
+                        reference.blend(blendMode, x + u, y + v, color);
+                    }
+                }
+                break;
+            case 2: {
+                // 8x8 bitmap, partially clipped
+                canvas.drawBitmap1bit(x, y - 4, 8, 8, bitmap);
+                for (int v = 0; v < 8; ++v) {
+                    for (int u = 0; u < 8; ++u) {
+                        bool bit = (bitmap[v] >> u) & 1;
+                        reference.blend(blendMode, x + u, y - 4 + v, bit ? color : 0);
+                    }
+                }
+                break;
+            }
+            }
+        }
+
+        expectTrue(reference.equals(frameBuffer));
+    }
+
+    CASE("dirty rows") {
+        static uint32_t data[Width * Height / FrameBuffer4bit::PixelsPerWord];
+        float brightness = 1.f;
+        FrameBuffer4bit frameBuffer(Width, Height, data);
+        Canvas canvas(frameBuffer, brightness);
+
+        // new frame buffer needs a full update
+        expectTrue(frameBuffer.isDirty());
+        expectEqual(frameBuffer.dirtyTop(), 0);
+        expectEqual(frameBuffer.dirtyBottom(), Height - 1);
+
+        frameBuffer.clearDirty();
+        expectFalse(frameBuffer.isDirty());
+
+        canvas.point(10, 20);
+        expectEqual(frameBuffer.dirtyTop(), 20);
+        expectEqual(frameBuffer.dirtyBottom(), 20);
+
+        canvas.hline(0, 5, 10);
+        canvas.vline(100, 30, 4);
+        expectEqual(frameBuffer.dirtyTop(), 5);
+        expectEqual(frameBuffer.dirtyBottom(), 33);
+
+        frameBuffer.clearDirty();
+        canvas.fillRect(0, 60, 10, 10);
+        expectEqual(frameBuffer.dirtyTop(), 60);
+        expectEqual(frameBuffer.dirtyBottom(), Height - 1);
+
+        frameBuffer.clearDirty();
+        canvas.drawText(0, 12, "TEST");
+        expectTrue(frameBuffer.isDirty());
+        expectTrue(frameBuffer.dirtyTop() >= 6);
+        expectTrue(frameBuffer.dirtyBottom() <= 12);
+
+        // clipped primitives do not touch the frame buffer
+        frameBuffer.clearDirty();
+        canvas.point(-1, 10);
+        canvas.hline(0, Height, 10);
+        canvas.drawText(0, -20, "TEST");
+        expectFalse(frameBuffer.isDirty());
+
+        canvas.fill();
+        expectEqual(frameBuffer.dirtyTop(), 0);
+        expectEqual(frameBuffer.dirtyBottom(), Height - 1);
+    }
+}
@@ -0,0 +1,156 @@
+#include "UnitTest.h"
+
+#include "core/gfx/Canvas.h"
+#include "core/gfx/fonts/tiny5x5.h"
+#include "core/gfx/fonts/ati8x8.h"
+#include "core/utils/StringBuilder.h"
+
+#include <cstdint>
+#include <cstring>
+
+static constexpr int Width = 256;
+static constexpr int Height = 64;
+
+static const BlendMode blendModes[] = { BlendMode::Set, BlendMode::Add, BlendMode::Sub };
+
+// previous text rendering decoding the packed glyph bitmap for every glyph
+static void drawTextBitmap(Canvas &canvas, int x, int y, const char *str) {
+    const auto &font = canvas.font() == Font::Small ? ati8x8 : tiny5x5;
+    while (*str != '\0') {
+        auto c = *str++;
+        if (c < font.first || c > font.last) {
+            continue;
+        }
+        const auto &g = font.glyphs[c - font.first];
+        canvas.drawBitmap1bit(x + g.xOffset, y + g.yOffset, g.width, g.height, &font.bitmap[g.offset]);
+        x += g.xAdvance;
+    }
+}
+
+// draws a frame similar to the note sequence edit page showing the note layer
+template<typename DrawText>
+static void drawNoteSequenceEditFrame(Canvas &canvas, int frame, DrawText drawText) {
+    static const char *functionNames[] = { "GATE", "RETRIG", "LENGTH", "NOTE", "COND" };
+    static const char *noteNames[] = { "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B" };
+    const int stepWidth = Width / 16;
+
+    canvas.setBlendMode(BlendMode::Set);
+    canvas.setColor(Color::None);
+    canvas.fill();
+
+    // header
+    canvas.setFont(Font::Tiny);
+    canvas.setColor(Color::Bright);
+    canvas.fillRect(1, 1, 6, 7);
+    canvas.setBlendMode(BlendMode::Sub);
+    drawText(canvas, 2, 6, "A");
+    canvas.setBlendMode(BlendMode::Set);
+    drawText(canvas, 10, 6, FixedStringBuilder<8>("%.1f", 120.f));
+    drawText(canvas, 40, 6, "T1");
+    drawText(canvas, 60, 6, FixedStringBuilder<8>("P%d", 1));
+    drawText(canvas, 200, 6, "STEPS");
+    canvas.setColor(Color::Medium);
+    canvas.hline(0, 9, Width);
+
+    // steps
+    int currentStep = frame % 16;
+    for (int i = 0; i < 16; ++i) {
+        int x = i * stepWidth;
+        int y = 20;
+
+        canvas.setColor(i == currentStep ? Color::Bright : Color::Medium);
+        FixedStringBuilder<8> index("%d", i + 1);
+        drawText(canvas, x + (stepWidth - canvas.textWidth(index) + 1) / 2, y - 2, index);
+
+        canvas.drawRect(x + 2, y + 2, stepWidth - 4, stepWidth - 4);
+        if (i % 3 != 0) {
+            canvas.setColor(Color::Bright);
+            canvas.fillRect(x + 4, y + 4, stepWidth - 8, stepWidth - 8);
+        }
+
+        canvas.setColor(Color::Bright);
+        const char *noteName = noteNames[(i * 5) % 12];
+        drawText(canvas, x + (stepWidth - canvas.textWidth(noteName) + 1) / 2, y + 20, noteName);
+        FixedStringBuilder<8> octave("%d", 3 + i / 6);
+        drawText(canvas, x + (stepWidth - canvas.textWidth(octave) + 1) / 2, y + 27, octave);
+    }
+
+    // footer
+    canvas.setColor(Color::Medium);
+    canvas.hline(0, Height - 10, Width);
+    for (int i = 0; i < 5; ++i) {
+        int x0 = (Width * i) / 5;
+        int x1 = (Width * (i + 1)) / 5;
+        canvas.vline(x1, Height - 9, 9);
+        canvas.setColor(i == 3 ? Color::Bright : Color::Medium);
+        drawText(canvas, x0 + (x1 - x0 + 1 - canvas.textWidth(functionNames[i])) / 2, Height - 3, functionNames[i]);
+    }
+}
+
+UNIT_TEST("TextRendering") {
+
+    CASE("glyph rows match bitmap rendering") {
+        static uint32_t dataA[Width * Height / FrameBuffer4bit::PixelsPerWord];
+        static uint32_t dataB[Width * Height / FrameBuffer4bit::PixelsPerWord];
+        float brightness = 1.f;
+        FrameBuffer4bit frameBufferA(Width, Height, dataA);
+        FrameBuffer4bit frameBufferB(Width, Height, dataB);
+        Canvas canvasA(frameBufferA, brightness);
+        Canvas canvasB(frameBufferB, brightness);
+
+        char text[128];
+        int length = 0;
+        for (int c = 16; c < 127; ++c) {
+            text[length++] = c;
+        }
+        text[length] = '\0';
+
+        for (auto font : { Font::Tiny, Font::Small }) {
+            for (auto blendMode : blendModes) {
+                // start with a pattern to check blending and clearing of the glyph box
+                for (auto canvas : { &canvasA, &canvasB }) {
+                    canvas->setBlendMode(BlendMode::Set);
+                    canvas->setColorValue(0x6);
+                    canvas->fill();
+                    canvas->setFont(font);
+                    canvas->setBlendMode(blendMode);
+                    canvas->setColorValue(0xb);
+                }
+                // positions clipped at all edges and at every offset within a word
+                for (int i = 0; i < 24; ++i) {
+                    int x = i * 11 - 30 - (i % 8);
+                    int y = (i * 7) % (Height + 12) - 4;
+                    canvasA.drawText(x, y, text + (i * 5) % length);
+                    drawTextBitmap(canvasB, x, y, text + (i * 5) % length);
+                }
+                expectTrue(std::memcmp(dataA, dataB, sizeof(dataA)) == 0);
+            }
+        }
+    }
+
+    CASE("benchmark note sequence edit frame") {
+        static uint32_t data[Width * Height / FrameBuffer4bit::PixelsPerWord];
+        float brightness = 1.f;
+        FrameBuffer4bit frameBuffer(Width, Height, data);
+        Canvas canvas(frameBuffer, brightness);
+        const int frames = 5000;
+        Timer timer;
+
+        timer.reset();
+        for (int frame = 0; frame < frames; ++frame) {
+            drawNoteSequenceEditFrame(canvas, frame, drawTextBitmap);
+        }
+        uint32_t bitmapTime = timer.elapsed();
+
+        timer.reset();
+        for (int frame = 0; frame < frames; ++frame) {
+            drawNoteSequenceEditFrame(canvas, frame, [] (Canvas &canvas, int x, int y, const char *str) {
+                canvas.drawText(x, y, str);
+            });
+        }
+        uint32_t glyphTime = timer.elapsed();
+
+        DBG("%d frames: glyph bitmaps = %.1f us/frame, glyph rows = %.1f us/frame",
+            frames, float(bitmapTime) / frames, float(glyphTime) / frames);
+    }
+}
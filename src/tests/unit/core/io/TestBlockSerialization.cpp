@@ -0,0 +1,264 @@
+#include "UnitTest.h"
+
+#include "MemoryReaderWriter.h"
+
+#include "core/hash/FnvHash.h"
+#include "core/io/VersionedSerializedWriter.h"
+#include "core/io/VersionedSerializedReader.h"
+
+#include <array>
+
+#include <cstring>
+
+// models the layout of the project data: tracks x patterns x sequences of steps
+
+static constexpr int StepCount = 64;
+static constexpr int PatternCount = 16;
+static constexpr int TrackCount = 8;
+
+// step data was stored as 16 bit in version 1
+#define VERSION(_x_) (_x_)
+
+struct Step {
+    uint32_t data0;
+    uint32_t data1;
+
+    void write(VersionedSerializedWriter &writer) const {
+        writer.write(data0);
+        writer.write(data1);
+    }
+
+    void read(VersionedSerializedReader &reader) {
+        reader.read(data0);
+        if (reader.dataVersion() < VERSION(2)) {
+            reader.readAs<uint16_t>(data1);
+        } else {
+            reader.read(data1);
+        }
+    }
+};
+
+struct Sequence {
+    uint8_t divisor;
+    uint8_t firstStep;
+    uint8_t lastStep;
+    std::array<Step, StepCount> steps;
+
+    void writeFields(VersionedSerializedWriter &writer) const {
+        writer.write(divisor);
+        writer.write(firstStep);
+        writer.write(lastStep);
+        for (const auto &step : steps) {
+            step.write(writer);
+        }
+    }
+
+    void writeBlock(VersionedSerializedWriter &writer) const {
+        writer.write(divisor);
+        writer.write(firstStep);
+        writer.write(lastStep);
+        writer.write(steps.data(), sizeof(steps));
+    }
+
+    void readFields(VersionedSerializedReader &reader) {
+        reader.read(divisor);
+        reader.read(firstStep);
+        reader.read(lastStep);
+        for (auto &step : steps) {
+            step.read(reader);
+        }
+    }
+
+    void readBlock(VersionedSerializedReader &reader) {
+        reader.read(divisor);
+        reader.read(firstStep);
+        reader.read(lastStep);
+        if (reader.dataVersion() < VERSION(2)) {
+            for (auto &step : steps) {
+                step.read(reader);
+            }
+        } else {
+            reader.read(steps.data(), sizeof(steps), 0);
+        }
+    }
+
+    bool operator==(const Sequence &other) const {
+        return divisor == other.divisor && firstStep == other.firstStep && lastStep == other.lastStep &&
+            std::memcmp(steps.data(), other.steps.data(), sizeof(steps)) == 0;
+    }
+};
+
+using Sequences = std::array<Sequence, TrackCount * PatternCount>;
+
+static void initSequences(Sequences &sequences) {
+    uint32_t seed = 1;
+    for (auto &sequence : sequences) {
+        sequence.divisor = seed & 0xff;
+        sequence.firstStep = (seed >> 8) & 0x3f;
+        sequence.lastStep = (seed >> 16) & 0x3f;
+        for (auto &step : sequence.steps) {
+            seed = seed * 1103515245 + 12345;
+            step.data0 = seed;
+            seed = seed * 1103515245 + 12345;
+            step.data1 = seed >> 16;
+        }
+    }
+}
+
+static constexpr size_t BufferSize = 128 * 1024;
+static uint8_t bufferA[BufferSize];
+static uint8_t bufferB[BufferSize];
+
+static size_t writeFields(const Sequences &sequences, uint8_t *buffer, uint32_t version = 2) {
+    MemoryWriter memoryWriter(buffer, BufferSize);
+    VersionedSerializedWriter writer([&memoryWriter] (const void *data, size_t len) { memoryWriter.write(data, len); }, version);
+    for (const auto &sequence : sequences) {
+        if (version < VERSION(2)) {
+            // version 1 format
+            writer.write(sequence.divisor);
+            writer.write(sequence.firstStep);
+            writer.write(sequence.lastStep);
+            for (const auto &step : sequence.steps) {
+                writer.write(step.data0);
+                writer.write(uint16_t(step.data1));
+            }
+        } else {
+            sequence.writeFields(writer);
+        }
+    }
+    writer.writeHash();
+    return memoryWriter.bytesWritten();
+}
+
+static size_t writeBlock(const Sequences &sequences, uint8_t *buffer) {
+    MemoryWriter memoryWriter(buffer, BufferSize);
+    VersionedSerializedWriter writer(memoryWriter, 2);
+    for (const auto &sequence : sequences) {
+        sequence.writeBlock(writer);
+    }
+    writer.writeHash();
+    return memoryWriter.bytesWritten();
+}
+
+static bool readFields(Sequences &sequences, const uint8_t *buffer) {
+    MemoryReader memoryReader(buffer, BufferSize);
+    VersionedSerializedReader reader([&memoryReader] (void *data, size_t len) { memoryReader.read(data, len); }, 2);
+    for (auto &sequence : sequences) {
+        sequence.readFields(reader);
+    }
+    return reader.checkHash();
+}
+
+static bool readBlock(Sequences &sequences, const uint8_t *buffer) {
+    MemoryReader memoryReader(buffer, BufferSize);
+    VersionedSerializedReader reader(memoryReader, 2);
+    for (auto &sequence : sequences) {
+        sequence.readBlock(reader);
+    }
+    return reader.checkHash();
+}
+
+UNIT_TEST("BlockSerialization") {
+
+    CASE("block hash matches byte hash") {
+        uint8_t data[16];
+        for (size_t i = 0; i < sizeof(data); ++i) {
+            data[i] = i * 37 + 11;
+        }
+        for (size_t len = 0; len <= sizeof(data); ++len) {
+            FnvHash blockHash;
+            FnvHash byteHash;
+            blockHash(data, len);
+            for (size_t i = 0; i < len; ++i) {
+                byteHash(data[i]);
+            }
+            expectEqual(blockHash.result(), byteHash.result());
+        }
+    }
+
+    CASE("block writes match field writes") {
+        static Sequences sequences;
+        initSequences(sequences);
+
+        std::memset(bufferA, 0, BufferSize);
+        std::memset(bufferB, 0, BufferSize);
+        size_t sizeA = writeFields(sequences, bufferA);
+        size_t sizeB = writeBlock(sequences, bufferB);
+
+        expectEqual(sizeA, sizeB);
+        expectTrue(std::memcmp(bufferA, bufferB, sizeA) == 0);
+    }
+
+    CASE("round trip") {
+        static Sequences sequences;
+        static Sequences sequencesA;
+        static Sequences sequencesB;
+        initSequences(sequences);
+
+        writeBlock(sequences, bufferA);
+
+        // read with field and block reader
+        std::memset(&sequencesA, 0, sizeof(sequencesA));
+        std::memset(&sequencesB, 0, sizeof(sequencesB));
+        expectTrue(readFields(sequencesA, bufferA));
+        expectTrue(readBlock(sequencesB, bufferA));
+        expectTrue(sequencesA == sequences);
+        expectTrue(sequencesB == sequences);
+
+        // corrupted data fails the hash check
+        bufferA[1000] ^= 0x1;
+        expectFalse(readBlock(sequencesB, bufferA));
+    }
+
+    CASE("round trip older version") {
+        static Sequences sequences;
+        static Sequences sequencesA;
+        initSequences(sequences);
+        for (auto &sequence : sequences) {
+            for (auto &step : sequence.steps) {
+                step.data1 &= 0xffff;
+            }
+        }
+
+        writeFields(sequences, bufferA, 1);
+
+        std::memset(&sequencesA, 0, sizeof(sequencesA));
+        expectTrue(readBlock(sequencesA, bufferA));
+        expectTrue(sequencesA == sequences);
+    }
+
+    CASE("benchmark") {
+        static Sequences sequences;
+        initSequences(sequences);
+        const int iterations = 20;
+        Timer timer;
+
+        timer.reset();
+        for (int i = 0; i < iterations; ++i) {
+            writeFields(sequences, bufferA);
+        }
+        uint32_t writeFieldsTime = timer.elapsed();
+
+        timer.reset();
+        for (int i = 0; i < iterations; ++i) {
+            writeBlock(sequences, bufferA);
+        }
+        uint32_t writeBlockTime = timer.elapsed();
+
+        timer.reset();
+        for (int i = 0; i < iterations; ++i) {
+            readFields(sequences, bufferA);
+        }
+        uint32_t readFieldsTime = timer.elapsed();
+
+        timer.reset();
+        for (int i = 0; i < iterations; ++i) {
+            readBlock(sequences, bufferA);
+        }
+        uint32_t readBlockTime = timer.elapsed();
+
+        DBG("write: fields = %.1f us, blocks = %.1f us", float(writeFieldsTime) / iterations, float(writeBlockTime) / iterations);
+        DBG("read: fields = %.1f us, blocks = %.1f us", float(readFieldsTime) / iterations, float(readBlockTime) / iterations);
+    }
+
+}
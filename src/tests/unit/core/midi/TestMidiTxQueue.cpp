@@ -0,0 +1,317 @@
+#include "UnitTest.h"
+
+#include "core/midi/MidiTxQueue.h"
+#include "core/midi/MidiParser.h"
+
+#include <vector>
+
+#include <cstdint>
+
+template<size_t Capacity>
+static std::vector<uint8_t> drain(MidiTxQueue<Capacity> &queue) {
+    std::vector<uint8_t> bytes;
+    uint8_t data;
+    while (queue.nextByte(data)) {
+        bytes.push_back(data);
+    }
+    return bytes;
+}
+
+static std::vector<MidiMessage> parse(const std::vector<uint8_t> &bytes) {
+    std::vector<MidiMessage> messages;
+    MidiParser parser;
+    for (auto data : bytes) {
+        if (parser.feed(data)) {
+            messages.push_back(parser.message());
+        }
+    }
+    return messages;
+}
+
+static bool equal(const MidiMessage &a, const MidiMessage &b) {
+    return a.length() == b.length() && a.status() == b.status() &&
+        (a.length() < 2 || a.data0() == b.data0()) &&
+        (a.length() < 3 || a.data1() == b.data1());
+}
+
+UNIT_TEST("MidiTxQueue") {
+
+    CASE("running status") {
+        MidiTxQueue<16> queue;
+        queue.push(MidiMessage::makeNoteOn(0, 60));
+        queue.push(MidiMessage::makeNoteOn(0, 64));
+        queue.push(MidiMessage(MidiMessage::Tick));
+        queue.push(MidiMessage::makeNoteOn(0, 67));
+        queue.push(MidiMessage::makeNoteOn(1, 60));
+
+        auto bytes = drain(queue);
+        std::vector<uint8_t> expected = { 0x90, 60, 127, 64, 127, 0xf8, 67, 127, 0x91, 60, 127 };
+        expectEqual(bytes.size(), expected.size());
+        for (size_t i = 0; i < std::min(bytes.size(), expected.size()); ++i) {
+            expectEqual(bytes[i], expected[i]);
+        }
+        expectEqual(int(queue.stats().bytesSaved), 2);
+        expectTrue(queue.empty());
+    }
+
+    CASE("system messages cancel running status") {
+        MidiTxQueue<16> queue;
+        queue.push(MidiMessage::makeNoteOn(0, 60));
+        queue.push(MidiMessage(MidiMessage::SongSelect, 1));
+        queue.push(MidiMessage::makeNoteOn(0, 60));
+        auto bytes = drain(queue);
+        expectEqual(int(bytes.size()), 8);
+        expectEqual(bytes[5], uint8_t(0x90));
+
+        // running status restarts after reset
+        queue.push(MidiMessage::makeNoteOn(0, 60));
+        queue.resetRunningStatus();
+        queue.push(MidiMessage::makeNoteOn(0, 60));
+        expectEqual(int(drain(queue).size()), 5);
+    }
+
+    CASE("coalesce control changes") {
+        MidiTxQueue<16> queue;
+        queue.push(MidiMessage::makeControlChange(0, 1, 10));
+        queue.push(MidiMessage::makeControlChange(0, 2, 20));
+        queue.push(MidiMessage::makeControlChange(0, 1, 11));
+        queue.push(MidiMessage::makePitchBend(0, 100));
+        queue.push(MidiMessage::makePitchBend(0, 200));
+        queue.push(MidiMessage::makeControlChange(1, 1, 12));
+
+        auto messages = parse(drain(queue));
+        expectEqual(int(messages.size()), 4);
+        expectTrue(equal(messages[0], MidiMessage::makeControlChange(0, 1, 11)));
+        expectTrue(equal(messages[1], MidiMessage::makeControlChange(0, 2, 20)));
+        expectTrue(equal(messages[2], MidiMessage::makePitchBend(0, 200)));
+        expectTrue(equal(messages[3], MidiMessage::makeControlChange(1, 1, 12)));
+        expectEqual(int(queue.stats().coalesced), 2);
+    }
+
+    CASE("keep order with notes and parameter controls") {
+        MidiTxQueue<16> queue;
+        queue.push(MidiMessage::makeControlChange(0, 1, 10));
+        queue.push(MidiMessage::makeNoteOn(0, 60));
+        queue.push(MidiMessage::makeControlChange(0, 1, 11));
+        queue.push(MidiMessage::makeControlChange(0, 1, 12));
+        queue.push(MidiMessage::makeControlChange(0, 99, 1));
+        queue.push(MidiMessage::makeControlChange(0, 6, 1));
+        queue.push(MidiMessage::makeControlChange(0, 99, 2));
+        queue.push(MidiMessage::makeControlChange(0, 6, 2));
+        queue.push(MidiMessage::makeControlChange(0, 1, 13));
+
+        auto messages = parse(drain(queue));
+        expectEqual(int(messages.size()), 8);
+        expectTrue(equal(messages[0], MidiMessage::makeControlChange(0, 1, 10)));
+        expectTrue(equal(messages[1], MidiMessage::makeNoteOn(0, 60)));
+        expectTrue(equal(messages[2], MidiMessage::makeControlChange(0, 1, 12)));
+        expectTrue(equal(messages[4], MidiMessage::makeControlChange(0, 6, 1)));
+        expectTrue(equal(messages[6], MidiMessage::makeControlChange(0, 6, 2)));
+        expectTrue(equal(messages[7], MidiMessage::makeControlChange(0, 1, 13)));
+        expectEqual(int(queue.stats().coalesced), 1);
+    }
+
+    CASE("drops") {
+        MidiTxQueue<4> queue;
+        for (int i = 0; i < 4; ++i) {
+            expectTrue(queue.push(MidiMessage::makeNoteOn(0, i)));
+        }
+        expectTrue(queue.full());
+        expectFalse(queue.push(MidiMessage::makeNoteOn(0, 4)));
+        expectEqual(int(queue.stats().drops), 1);
+        // continuous controllers still coalesce into a pending message
+        queue.clear();
+        for (int i = 0; i < 4; ++i) {
+            expectTrue(queue.push(MidiMessage::makeControlChange(0, i, 0)));
+        }
+        expectTrue(queue.push(MidiMessage::makeControlChange(0, 3, 1)));
+        expectEqual(int(queue.stats().drops), 0);
+    }
+
+    CASE("real-time lane") {
+        MidiTxQueue<16> queue;
+        queue.push(MidiMessage::makeNoteOn(0, 60));
+        queue.push(MidiMessage::makeNoteOn(0, 64));
+
+        // real-time bytes wait for the current message and go ahead of queued messages
+        uint8_t data;
+        expectTrue(queue.nextByte(data));
+        expectEqual(data, uint8_t(0x90));
+        queue.pushRealTime(MidiMessage::Start);
+        queue.pushRealTime(MidiMessage::Tick);
+        auto bytes = drain(queue);
+        std::vector<uint8_t> expected = { 60, 127, 0xfa, 0xf8, 64, 127 };
+        expectEqual(bytes.size(), expected.size());
+        for (size_t i = 0; i < std::min(bytes.size(), expected.size()); ++i) {
+            expectEqual(bytes[i], expected[i]);
+        }
+
+        // real-time bytes are sent from an empty queue
+        queue.pushRealTime(MidiMessage::Stop);
+        expectFalse(queue.empty());
+        expectTrue(queue.nextByte(data));
+        expectEqual(data, uint8_t(0xfc));
+        expectTrue(queue.empty());
+
+        // the lane has a limited size
+        for (int i = 0; i < 8; ++i) {
+            expectTrue(queue.pushRealTime(MidiMessage::Tick));
+        }
+        expectFalse(queue.pushRealTime(MidiMessage::Tick));
+        expectEqual(int(queue.stats().realTimeDrops), 1);
+    }
+
+    CASE("clock jitter under load") {
+        // 16 outputs send a CC every millisecond, clock ticks every 20ms,
+        // the uart sends a byte every 320us
+        const int Outputs = 16;
+        const int Duration = 10000;
+        const int ByteTime = 320;
+        const int ClockPeriod = 20000;
+
+        auto run = [&] (bool realTime) {
+            MidiTxQueue<32> queue;
+            int maxDelay = 0;
+            int lastTick = -1;
+            int ticks = 0;
+            for (int time = 0; time < Duration * 1000; time += 10) {
+                if (time % ClockPeriod == 0) {
+                    if (realTime) {
+                        queue.pushRealTime(MidiMessage::Tick);
+                    } else {
+                        queue.push(MidiMessage(MidiMessage::Tick));
+                    }
+                    lastTick = time;
+                }
+                if (time % 1000 == 0) {
+                    for (int output = 0; output < Outputs; ++output) {
+                        queue.push(MidiMessage::makeControlChange(output, 1, (time / 1000 + output) & 0x7f));
+                    }
+                }
+                uint8_t data;
+                if (time % ByteTime == 0 && queue.nextByte(data) && data == MidiMessage::Tick) {
+                    maxDelay = std::max(maxDelay, time - lastTick);
+                    ++ticks;
+                }
+            }
+            DBG("%s: %d ticks, max delay = %.2f ms", realTime ? "real-time lane" : "queued", ticks, maxDelay / 1000.0);
+            return maxDelay;
+        };
+
+        int queuedDelay = run(false);
+        int realTimeDelay = run(true);
+
+        // at most the remaining bytes of the current message plus the byte in transmission
+        expectTrue(realTimeDelay <= 3 * ByteTime);
+        expectTrue(realTimeDelay < queuedDelay);
+    }
+
+    CASE("dense multi output throughput") {
+        // 16 outputs send a CC every millisecond and a note every 125ms,
+        // the uart sends a byte every 320us
+        const int Outputs = 16;
+        const int Duration = 10000;
+        const int ByteTime = 320;
+
+        struct Result {
+            uint32_t bytes = 0;
+            uint32_t drops = 0;
+            uint32_t notes = 0;
+            double noteLatencySum = 0;
+            int noteLatencyMax = 0;
+        };
+
+        // previous driver: 64 byte buffer, no running status, no coalescing
+        auto runPlain = [&] () {
+            Result result;
+            std::vector<uint8_t> buffer;
+            std::vector<int> noteEnd;   // byte count at which a queued note is sent
+            std::vector<int> noteTime;
+            uint32_t sent = 0;
+            for (int time = 0; time < Duration * 1000; time += 10) {
+                if (time % 1000 == 0) {
+                    int ms = time / 1000;
+                    for (int output = 0; output < Outputs; ++output) {
+                        MidiMessage message = (ms + output * 8) % 125 == 0 ?
+                            MidiMessage::makeNoteOn(output, 60) :
+                            MidiMessage::makeControlChange(output, 1, (ms + output) & 0x7f);
+                        if (buffer.size() + message.length() > 64) {
+                            ++result.drops;
+                            continue;
+                        }
+                        buffer.insert(buffer.end(), message.raw(), message.raw() + message.length());
+                        if (message.isNoteOn()) {
+                            noteEnd.push_back(sent + buffer.size());
+                            noteTime.push_back(time);
+                        }
+                    }
+                }
+                if (time % ByteTime == 0 && !buffer.empty()) {
+                    buffer.erase(buffer.begin());
+                    ++sent;
+                    ++result.bytes;
+                    for (size_t i = 0; i < noteEnd.size(); ++i) {
+                        if (noteEnd[i] == int(sent)) {
+                            int latency = time - noteTime[i];
+                            result.noteLatencySum += latency;
+                            result.noteLatencyMax = std::max(result.noteLatencyMax, latency);
+                            ++result.notes;
+                        }
+                    }
+                }
+            }
+            return result;
+        };
+
+        auto runQueue = [&] () {
+            Result result;
+            MidiTxQueue<32> queue;
+            MidiParser parser;
+            std::vector<int> noteTime;
+            for (int time = 0; time < Duration * 1000; time += 10) {
+                if (time % 1000 == 0) {
+                    int ms = time / 1000;
+                    for (int output = 0; output < Outputs; ++output) {
+                        MidiMessage message = (ms + output * 8) % 125 == 0 ?
+                            MidiMessage::makeNoteOn(output, 60) :
+                            MidiMessage::makeControlChange(output, 1, (ms + output) & 0x7f);
+                        if (queue.push(message) && message.isNoteOn()) {
+                            noteTime.push_back(time);
+                        }
+                    }
+                }
+                uint8_t data;
+                if (time % ByteTime == 0 && queue.nextByte(data)) {
+                    ++result.bytes;
+                    if (parser.feed(data) && parser.message().isNoteOn()) {
+                        int latency = time - noteTime[result.notes];
+                        result.noteLatencySum += latency;
+                        result.noteLatencyMax = std::max(result.noteLatencyMax, latency);
+                        ++result.notes;
+                    }
+                }
+            }
+            result.drops = queue.stats().drops;
+            DBG("running status/coalescing saved %d bytes, coalesced %d messages",
+                int(queue.stats().bytesSaved), int(queue.stats().coalesced));
+            return result;
+        };
+
+        auto plain = runPlain();
+        auto optimized = runQueue();
+
+        auto printResult = [] (const char *name, const Result &result) {
+            DBG("%s: %d bytes sent, %d drops, %d notes, note latency mean = %.2f ms, max = %.2f ms",
+                name, int(result.bytes), int(result.drops), int(result.notes),
+                result.notes > 0 ? result.noteLatencySum / result.notes / 1000.0 : 0.0, result.noteLatencyMax / 1000.0);
+        };
+        printResult("plain", plain);
+        printResult("tx queue", optimized);
+
+        expectEqual(int(optimized.drops), 0);
+        // all notes are sent, apart from the ones still queued at the end
+        expectTrue(int(optimized.notes) > Outputs * Duration / 125 - Outputs);
+        expectTrue(optimized.notes > plain.notes);
+        expectTrue(optimized.noteLatencySum / optimized.notes < plain.noteLatencySum / plain.notes);
+    }
+}
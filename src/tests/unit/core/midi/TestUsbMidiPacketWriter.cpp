@@ -0,0 +1,120 @@
+#include "UnitTest.h"
+
+#include "core/midi/UsbMidiPacketWriter.h"
+
+#include <vector>
+
+#include <cstdint>
+
+static uint8_t payloadPool[256];
+
+static std::vector<uint8_t> packet(const uint8_t *data, size_t size) {
+    return std::vector<uint8_t>(data, data + size);
+}
+
+UNIT_TEST("UsbMidiPacketWriter") {
+
+    CASE("event packets") {
+        UsbMidiPacketWriter<64> writer;
+        expectTrue(writer.empty());
+        expectTrue(writer.write(0, MidiMessage::makeNoteOn(1, 60, 100)));
+        expectTrue(writer.write(1, MidiMessage::makeProgramChange(2, 5)));
+        expectTrue(writer.write(0, MidiMessage(MidiMessage::Tick)));
+        expectTrue(writer.write(0, MidiMessage(MidiMessage::SongSelect, 3)));
+        expectTrue(writer.write(0, MidiMessage(MidiMessage::TuneRequest)));
+        expectEqual(writer.events(), size_t(5));
+
+        std::vector<uint8_t> expected = {
+            0x09, 0x91, 60, 100,
+            0x1c, 0xc2, 5, 0,
+            0x0f, 0xf8, 0, 0,
+            0x02, 0xf3, 3, 0,
+            0x05, 0xf6, 0, 0,
+        };
+        expectTrue(packet(writer.data(), writer.size()) == expected);
+    }
+
+    CASE("batch up to the max packet size") {
+        UsbMidiPacketWriter<64> writer;
+        for (int i = 0; i < 16; ++i) {
+            expectFalse(writer.full());
+            expectTrue(writer.write(0, MidiMessage::makeNoteOn(0, i)));
+        }
+        expectTrue(writer.full());
+        expectFalse(writer.write(0, MidiMessage::makeNoteOn(0, 16)));
+        expectEqual(writer.size(), size_t(64));
+
+        // endpoints with smaller packets
+        writer.setMaxSize(10);
+        expectTrue(writer.write(0, MidiMessage::makeNoteOn(0, 0)));
+        expectTrue(writer.write(0, MidiMessage::makeNoteOn(0, 1)));
+        expectFalse(writer.write(0, MidiMessage::makeNoteOn(0, 2)));
+        expectEqual(writer.size(), size_t(8));
+    }
+
+    CASE("system exclusive continues in the next transfer") {
+        MidiMessage::setPayloadPool(payloadPool, sizeof(payloadPool));
+
+        uint8_t payload[40];
+        for (size_t i = 0; i < sizeof(payload); ++i) {
+            payload[i] = i;
+        }
+        auto message = MidiMessage::makeSystemExclusive(payload, sizeof(payload));
+
+        // 42 bytes including framing need 14 events
+        UsbMidiPacketWriter<16> writer;
+        std::vector<uint8_t> bytes;
+        int transfers = 0;
+        while (!writer.write(2, message)) {
+            bytes.insert(bytes.end(), writer.data(), writer.data() + writer.size());
+            writer.clear();
+            ++transfers;
+        }
+        bytes.insert(bytes.end(), writer.data(), writer.data() + writer.size());
+        ++transfers;
+        expectEqual(transfers, 4);
+        expectEqual(int(bytes.size()), 14 * 4);
+
+        std::vector<uint8_t> sysex;
+        for (size_t i = 0; i < bytes.size(); i += 4) {
+            uint8_t code = bytes[i] & 0xf;
+            expectEqual(bytes[i] >> 4, 2);
+            expectEqual(code, uint8_t(i + 4 < bytes.size() ? 0x4 : 0x7));
+            sysex.insert(sysex.end(), &bytes[i + 1], &bytes[i + 1] + (code == 0x4 ? 3 : code - 0x4));
+        }
+        expectEqual(int(sysex.size()), 42);
+        expectEqual(sysex.front(), uint8_t(0xf0));
+        expectEqual(sysex.back(), uint8_t(0xf7));
+        for (size_t i = 0; i < sizeof(payload); ++i) {
+            expectEqual(sysex[1 + i], payload[i]);
+        }
+
+        // following messages share the transfer
+        expectTrue(writer.write(0, MidiMessage::makeNoteOn(0, 60)));
+        expectEqual(writer.events(), size_t(3));
+    }
+
+    CASE("transfers for a launchpad grid update") {
+        // 80 led updates and 16 notes, the previous driver sent a single event per transfer
+        UsbMidiPacketWriter<64> writer;
+        std::vector<MidiMessage> messages;
+        for (int i = 0; i < 80; ++i) {
+            messages.emplace_back(MidiMessage::makeNoteOn(0, i, i % 4));
+        }
+        for (int i = 0; i < 16; ++i) {
+            messages.emplace_back(MidiMessage::makeNoteOn(i, 60));
+        }
+
+        int transfers = 0;
+        for (const auto &message : messages) {
+            if (!writer.write(0, message)) {
+                writer.clear();
+                ++transfers;
+                writer.write(0, message);
+            }
+        }
+        ++transfers;
+        DBG("%d events in %d transfers", int(messages.size()), transfers);
+        expectEqual(transfers, 6);
+    }
+}
@@ -0,0 +1,185 @@
+#include "UnitTest.h"
+
+#include "core/utils/RingBuffer.h"
+
+#include <cstdint>
+
+// previous ring buffer implementation using volatile indices and modulo arithmetic
+template<typename T, size_t Size>
+class ModuloRingBuffer {
+public:
+    inline bool empty() const { return _read == _write; }
+
+    inline size_t writable() const { return (_read - _write - 1) % Size; }
+
+    inline void write(T value) {
+        size_t write = _write;
+        _buffer[write] = value;
+        _write = (write + 1) % Size;
+    }
+
+    inline T read() {
+        size_t read = _read;
+        T value = _buffer[read];
+        _read = (read + 1) % Size;
+        return value;
+    }
+
+private:
+    T _buffer[Size];
+    volatile size_t _read = 0;
+    volatile size_t _write = 0;
+};
+
+UNIT_TEST("RingBuffer") {
+
+    CASE("empty") {
+        RingBuffer<int, 8> buffer;
+        expectEqual(buffer.size(), size_t(8));
+        expectTrue(buffer.empty());
+        expectFalse(buffer.full());
+        expectEqual(buffer.readable(), size_t(0));
+        expectEqual(buffer.writable(), size_t(8));
+    }
+
+    CASE("write/read full capacity") {
+        RingBuffer<int, 8> buffer;
+        for (int round = 0; round < 5; ++round) {
+            for (int i = 0; i < 8; ++i) {
+                expectFalse(buffer.full());
+                buffer.write(round * 8 + i);
+            }
+            expectTrue(buffer.full());
+            expectEqual(buffer.entries(), size_t(8));
+            for (int i = 0; i < 8; ++i) {
+                expectFalse(buffer.empty());
+                expectEqual(buffer.read(), round * 8 + i);
+            }
+            expectTrue(buffer.empty());
+        }
+    }
+
+    CASE("read and replace") {
+        RingBuffer<int, 4> buffer;
+        buffer.write(1);
+        expectEqual(buffer.readAndReplace(), 1);
+        expectTrue(buffer.empty());
+    }
+
+    CASE("bulk write/read") {
+        RingBuffer<uint8_t, 16> buffer;
+        uint8_t data[32];
+        for (int i = 0; i < 32; ++i) {
+            data[i] = i;
+        }
+
+        // partial writes are limited to the free space
+        expectEqual(buffer.write(data, 10), size_t(10));
+        expectEqual(buffer.write(data + 10, 10), size_t(6));
+        expectTrue(buffer.full());
+        expectEqual(buffer.write(data, 1), size_t(0));
+
+        uint8_t result[32];
+        expectEqual(buffer.read(result, 12), size_t(12));
+        for (int i = 0; i < 12; ++i) {
+            expectEqual(result[i], uint8_t(i));
+        }
+
+        // wrap around the end of the buffer
+        expectEqual(buffer.write(data + 16, 12), size_t(12));
+        expectEqual(buffer.read(result, 32), size_t(16));
+        for (int i = 0; i < 16; ++i) {
+            expectEqual(result[i], uint8_t(12 + i));
+        }
+        expectTrue(buffer.empty());
+        expectEqual(buffer.read(result, 1), size_t(0));
+    }
+
+    CASE("bulk transfers at all offsets") {
+        RingBuffer<uint16_t, 32> buffer;
+        uint16_t next = 0;
+        uint16_t expected = 0;
+        for (size_t offset = 0; offset < 64; ++offset) {
+            for (size_t length = 0; length <= 32; ++length) {
+                uint16_t data[32];
+                for (size_t i = 0; i < length; ++i) {
+                    data[i] = next + i;
+                }
+                size_t written = buffer.write(data, length);
+                expectEqual(written, length);
+                next += written;
+
+                uint16_t result[32];
+                size_t read = buffer.read(result, length);
+                expectEqual(read, length);
+                for (size_t i = 0; i < read; ++i) {
+                    expectEqual(result[i], uint16_t(expected++));
+                }
+            }
+            buffer.write(next++);
+            expectEqual(buffer.read(), expected++);
+        }
+    }
+
+    CASE("benchmark draining MIDI bursts") {
+        // fill the buffer with a burst of 3 byte messages and drain it
+        const int Bursts = 1000000;
+        const size_t BurstSize = 63;
+        volatile uint32_t sum = 0;
+        Timer timer;
+
+        ModuloRingBuffer<uint8_t, 64> moduloBuffer;
+        timer.reset();
+        for (int burst = 0; burst < Bursts; ++burst) {
+            for (size_t i = 0; i < BurstSize; ++i) {
+                if (moduloBuffer.writable()) {
+                    moduloBuffer.write(uint8_t(burst + i));
+                }
+            }
+            uint32_t s = 0;
+            while (!moduloBuffer.empty()) {
+                s += moduloBuffer.read();
+            }
+            sum = sum + s;
+        }
+        uint32_t moduloTime = timer.elapsed();
+
+        RingBuffer<uint8_t, 64> ringBuffer;
+        timer.reset();
+        for (int burst = 0; burst < Bursts; ++burst) {
+            for (size_t i = 0; i < BurstSize; ++i) {
+                if (ringBuffer.writable()) {
+                    ringBuffer.write(uint8_t(burst + i));
+                }
+            }
+            uint32_t s = 0;
+            while (!ringBuffer.empty()) {
+                s += ringBuffer.read();
+            }
+            sum = sum + s;
+        }
+        uint32_t singleTime = timer.elapsed();
+
+        timer.reset();
+        for (int burst = 0; burst < Bursts; ++burst) {
+            uint8_t data[BurstSize];
+            for (size_t i = 0; i < BurstSize; ++i) {
+                data[i] = uint8_t(burst + i);
+            }
+            ringBuffer.write(data, BurstSize);
+            size_t length = ringBuffer.read(data, BurstSize);
+            uint32_t s = 0;
+            for (size_t i = 0; i < length; ++i) {
+                s += data[i];
+            }
+            sum = sum + s;
+        }
+        uint32_t bulkTime = timer.elapsed();
+
+        DBG("%d bursts of %d bytes: modulo = %.2f ns/byte, spsc = %.2f ns/byte, spsc bulk = %.2f ns/byte",
+            Bursts, int(BurstSize),
+            moduloTime * 1000.0 / (Bursts * BurstSize),
+            singleTime * 1000.0 / (Bursts * BurstSize),
+            bulkTime * 1000.0 / (Bursts * BurstSize));
+    }
+}
@@ -9,6 +9,7 @@
 #include "libs/stb/stb_image_write.h"
 #endif
 
+#include <cmath>
 #include <cstdint>
 
 const int Width = 32;
@@ -18,13 +19,30 @@ float brightness = 1.0;
 
 UNIT_TEST("Curve") {
 
+    CASE("evalLookup") {
+        const int Samples = 100000;
+        const float MaxError = 1e-4f;
+
+        for (int i = 0; i < Curve::Last; ++i) {
+            auto type = Curve::Type(i);
+            float maxError = 0.f;
+            for (int j = 0; j <= Samples; ++j) {
+                float x = float(j) / Samples;
+                float error = std::abs(Curve::evalLookup(type, x) - Curve::eval(type, x));
+                maxError = std::max(maxError, error);
+            }
+            DBG("shape %d: max error = %g", i + 1, maxError);
+            expectTrue(maxError < MaxError);
+        }
+    }
+
 #ifdef PLATFORM_SIM
 
     CASE("markdown") {
 
         auto drawCurve = [] (int index, const char *filename) {
-            uint8_t data[Width * Height];
-            FrameBuffer8bit framebuffer(Width, Height, data);
+            uint32_t data[Width * Height / FrameBuffer4bit::PixelsPerWord];
+            FrameBuffer4bit framebuffer(Width, Height, data);
             Canvas canvas(framebuffer, brightness);
 
             canvas.setBlendMode(BlendMode::Set);
@@ -55,11 +73,15 @@ UNIT_TEST("Curve") {
                 );
             }
 
-            for (int i = 0; i < Width * Height; ++i) {
-                data[i] = std::min(255, int(data[i]) * 0xf);
+            // unpack 4 bit pixels
+            uint8_t pixels[Width * Height];
+            for (int y = 0; y < Height; ++y) {
+                for (int x = 0; x < Width; ++x) {
+                    pixels[y * Width + x] = std::min(255, int(framebuffer.get(x, y)) * 0xf);
+                }
             }
 
-            stbi_write_png(filename, Width, Height, 1, data, Width * 1);
+            stbi_write_png(filename, Width, Height, 1, pixels, Width * 1);
         };
 
         FixedStringBuilder<4096> indices("| Index |");
@@ -0,0 +1,142 @@
+#include "UnitTest.h"
+
+#include "apps/sequencer/engine/MidiRouteIndex.h"
+#include "apps/sequencer/engine/MidiUtils.h"
+
+#include <array>
+#include <cstdint>
+
+using Event = Routing::MidiSource::Event;
+
+static Routing::MidiSource makeSource(Types::MidiPort port, int channel, Event event, int number, int noteRange = 2) {
+    Routing::MidiSource source;
+    source.source().setPort(port);
+    source.source().setChannel(channel);
+    source.setEvent(event);
+    source.setControlNumber(number);
+    source.setNoteRange(noteRange);
+    return source;
+}
+
+// reference implementation matching every route against the message
+static bool matchRoute(MidiPort port, const MidiMessage &message, const Routing::MidiSource &source) {
+    if (!MidiUtils::matchSource(port, message, source.source())) {
+        return false;
+    }
+    switch (source.event()) {
+    case Event::ControlAbsolute:
+    case Event::ControlRelative:
+        return message.isControlChange() && message.controlNumber() == source.controlNumber();
+    case Event::PitchBend:
+        return message.isPitchBend();
+    case Event::NoteMomentary:
+    case Event::NoteToggle:
+    case Event::NoteVelocity:
+        return (message.isNoteOn() || message.isNoteOff()) && message.note() == source.note();
+    case Event::NoteRange:
+        return (message.isNoteOn() || message.isNoteOff()) && message.note() >= source.note() && message.note() < source.note() + source.noteRange();
+    case Event::Last:
+        break;
+    }
+    return false;
+}
+
+static std::array<Routing::MidiSource, CONFIG_ROUTE_COUNT> makeSources() {
+    std::array<Routing::MidiSource, CONFIG_ROUTE_COUNT> sources;
+    for (int i = 0; i < CONFIG_ROUTE_COUNT; ++i) {
+        auto port = i % 2 ? Types::MidiPort::UsbMidi : Types::MidiPort::Midi;
+        int channel = i % 3 == 0 ? -1 : i % 16;
+        sources[i] = makeSource(port, channel, Event(i % int(Event::Last)), (i * 7) % 128, 2 + i);
+    }
+    return sources;
+}
+
+UNIT_TEST("MidiRouteIndex") {
+
+    CASE("empty") {
+        MidiRouteIndex index;
+        expectEqual(int(index.lookup(MidiPort::Midi, MidiMessage::makeControlChange(0, 1, 64))), 0);
+        expectEqual(int(index.lookup(MidiPort::Midi, MidiMessage::makeNoteOn(0, 60))), 0);
+        expectEqual(int(index.lookup(MidiPort::Midi, MidiMessage::makePitchBend(0, 0))), 0);
+    }
+
+    CASE("lookup matches reference") {
+        auto sources = makeSources();
+        MidiRouteIndex index;
+        for (int i = 0; i < CONFIG_ROUTE_COUNT; ++i) {
+            index.add(i, sources[i]);
+        }
+
+        for (auto port : { MidiPort::Midi, MidiPort::UsbMidi, MidiPort::CvGate }) {
+            for (int channel = 0; channel < 16; ++channel) {
+                for (int number = 0; number < 128; ++number) {
+                    for (const auto &message : {
+                        MidiMessage::makeControlChange(channel, number, 64),
+                        MidiMessage::makeNoteOn(channel, number),
+                        MidiMessage::makeNoteOff(channel, number),
+                        MidiMessage::makeProgramChange(channel, number),
+                        MidiMessage::makePitchBend(channel, number * 64 - 0x2000)
+                    }) {
+                        auto routes = index.lookup(port, message);
+                        for (int i = 0; i < CONFIG_ROUTE_COUNT; ++i) {
+                            bool indexed = (routes & (1 << i)) && MidiUtils::matchSource(port, message, sources[i].source());
+                            expectEqual(indexed, matchRoute(port, message, sources[i]));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    CASE("clear") {
+        MidiRouteIndex index;
+        index.add(3, makeSource(Types::MidiPort::Midi, -1, Event::ControlAbsolute, 10));
+        expectEqual(int(index.lookup(MidiPort::Midi, MidiMessage::makeControlChange(5, 10, 0))), 1 << 3);
+        index.clear();
+        expectEqual(int(index.lookup(MidiPort::Midi, MidiMessage::makeControlChange(5, 10, 0))), 0);
+    }
+
+    CASE("benchmark CC flood") {
+        // all routes listen to CCs on the same port, the flood hits a single route
+        std::array<Routing::MidiSource, CONFIG_ROUTE_COUNT> sources;
+        MidiRouteIndex index;
+        for (int i = 0; i < CONFIG_ROUTE_COUNT; ++i) {
+            sources[i] = makeSource(Types::MidiPort::Midi, 0, Event::ControlAbsolute, i);
+            index.add(i, sources[i]);
+        }
+
+        const int Messages = 1000000;
+        volatile uint32_t matches = 0;
+        Timer timer;
+
+        timer.reset();
+        for (int i = 0; i < Messages; ++i) {
+            MidiMessage message = MidiMessage::makeControlChange(0, (CONFIG_ROUTE_COUNT - 1) & 0x7f, i & 0x7f);
+            for (int routeIndex = 0; routeIndex < CONFIG_ROUTE_COUNT; ++routeIndex) {
+                if (matchRoute(MidiPort::Midi, message, sources[routeIndex])) {
+                    matches = matches + 1;
+                }
+            }
+        }
+        uint32_t linearTime = timer.elapsed();
+
+        timer.reset();
+        for (int i = 0; i < Messages; ++i) {
+            MidiMessage message = MidiMessage::makeControlChange(0, (CONFIG_ROUTE_COUNT - 1) & 0x7f, i & 0x7f);
+            auto routes = index.lookup(MidiPort::Midi, message);
+            while (routes) {
+                int routeIndex = __builtin_ctz(routes);
+                routes &= routes - 1;
+                if (MidiUtils::matchSource(MidiPort::Midi, message, sources[routeIndex].source())) {
+                    matches = matches + 1;
+                }
+            }
+        }
+        uint32_t indexTime = timer.elapsed();
+
+        expectEqual(int(matches), 2 * Messages);
+
+        DBG("%d messages: linear = %.1f ns/msg, indexed = %.1f ns/msg",
+            Messages, linearTime * 1000.0 / Messages, indexTime * 1000.0 / Messages);
+    }
+}
@@ -0,0 +1,99 @@
+#include "UnitTest.h"
+
+#include "apps/sequencer/ui/Page.cpp"
+#include "apps/sequencer/ui/PageManager.cpp"
+
+struct Pages {};
+
+class TestPage : public Page {
+public:
+    TestPage(PageManager &manager, Dependency dependencies) :
+        Page(manager),
+        _dependencies(dependencies)
+    {}
+
+    virtual Dependency dependencies() const override { return _dependencies; }
+
+    Dependency _dependencies;
+};
+
+UNIT_TEST("PageManager") {
+
+    CASE("draws after page switch") {
+        Pages pages;
+        PageManager manager(pages);
+        TestPage top(manager, Page::NoDependency);
+        TestPage page(manager, Page::StepDataDependency);
+
+        manager.push(&top);
+        expectTrue(manager.needsDraw(0));
+        expectFalse(manager.needsDraw(0));
+
+        manager.push(&page);
+        expectTrue(manager.needsDraw(0));
+        expectFalse(manager.needsDraw(0));
+
+        manager.pop();
+        expectTrue(manager.needsDraw(0));
+    }
+
+    CASE("draws only when dependencies changed") {
+        Pages pages;
+        PageManager manager(pages);
+        TestPage top(manager, Page::NoDependency);
+        TestPage page(manager, Page::SelectedTrackDependency | Page::StepDataDependency);
+
+        manager.push(&top);
+        manager.push(&page);
+        manager.needsDraw(0);
+
+        manager.invalidate(Page::PlayPositionDependency);
+        expectFalse(manager.needsDraw(0));
+
+        manager.invalidate(Page::StepDataDependency);
+        expectTrue(manager.needsDraw(0));
+        expectFalse(manager.needsDraw(0));
+
+        // message overlay is drawn on top of every page
+        manager.invalidate(Page::MessageDependency);
+        expectTrue(manager.needsDraw(0));
+
+        // all dependencies are invalidated on input
+        manager.invalidate();
+        expectTrue(manager.needsDraw(0));
+        expectFalse(manager.needsDraw(0));
+    }
+
+    CASE("animated pages draw every frame") {
+        Pages pages;
+        PageManager manager(pages);
+        TestPage top(manager, Page::NoDependency);
+        TestPage page(manager, Page::AnimationDependency);
+
+        manager.push(&top);
+        manager.push(&page);
+        expectTrue(manager.needsDraw(0));
+        expectTrue(manager.needsDraw(1));
+        expectTrue(manager.needsDraw(2));
+    }
+
+    CASE("scheduled draws") {
+        Pages pages;
+        PageManager manager(pages);
+        TestPage page(manager, Page::NoDependency);
+
+        manager.push(&page);
+        manager.needsDraw(0);
+
+        manager.scheduleDraw(200);
+        manager.scheduleDraw(100);
+        expectFalse(manager.needsDraw(99));
+        expectTrue(manager.needsDraw(100));
+        expectFalse(manager.needsDraw(250));
+
+        // deadlines wrap around with the tick counter
+        manager.scheduleDraw(10);
+        expectFalse(manager.needsDraw(0xfffffff0));
+        expectTrue(manager.needsDraw(10));
+    }
+}
@@ -0,0 +1,55 @@
+#include "UnitTest.h"
+
+#include "apps/sequencer/engine/TickTimes.h"
+
+#include <cstdint>
+
+UNIT_TEST("TickTimes") {
+
+    CASE("returns times of recent ticks") {
+        TickTimes<32> tickTimes;
+        for (uint32_t tick = 0; tick < 10; ++tick) {
+            tickTimes.record(tick, 1000 + tick * 100);
+        }
+        for (uint32_t tick = 0; tick < 10; ++tick) {
+            expectEqual(tickTimes.time(tick, 10, 0), 1000 + tick * 100);
+        }
+    }
+
+    CASE("returns fallback for ticks not generated yet") {
+        TickTimes<32> tickTimes;
+        tickTimes.record(0, 1000);
+        expectEqual(tickTimes.time(1, 1, 5000), uint32_t(5000));
+        expectEqual(tickTimes.time(40, 1, 5000), uint32_t(5000));
+    }
+
+    CASE("returns fallback when more than 32 ticks are pending") {
+        // the engine fell behind, ticks 0..39 were generated but not processed yet
+        TickTimes<32> tickTimes;
+        const uint32_t pending = 40;
+        for (uint32_t tick = 0; tick < pending; ++tick) {
+            tickTimes.record(tick, 1000 + tick * 100);
+        }
+        for (uint32_t tick = 0; tick < pending; ++tick) {
+            uint32_t time = tickTimes.time(tick, pending, 99999);
+            if (pending - tick <= 32) {
+                expectEqual(time, 1000 + tick * 100);
+            } else {
+                // slot was reused by a later tick, must not return that tick's time
+                expectEqual(time, uint32_t(99999));
+            }
+        }
+    }
+
+    CASE("handles tick counter wrap around") {
+        TickTimes<32> tickTimes;
+        uint32_t first = 0xfffffff0;
+        for (uint32_t i = 0; i < 64; ++i) {
+            tickTimes.record(first + i, i);
+        }
+        uint32_t next = first + 64;
+        expectEqual(tickTimes.time(next - 1, next, 99999), uint32_t(63));
+        expectEqual(tickTimes.time(next - 32, next, 99999), uint32_t(32));
+        expectEqual(tickTimes.time(next - 33, next, 99999), uint32_t(99999));
+    }
+}
@@ -0,0 +1,288 @@
+#include "UnitTest.h"
+
+#include "apps/sequencer/engine/TimingWheel.h"
+#include "apps/sequencer/engine/SortedQueue.h"
+
+#include "core/utils/Random.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <cstdint>
+
+struct Event {
+    uint32_t tick;
+    int id;
+};
+
+struct EventCompare {
+    bool operator()(const Event &a, const Event &b) {
+        return a.tick < b.tick;
+    }
+};
+
+// reference implementation keeping events in a sorted vector
+class ReferenceQueue {
+public:
+    ReferenceQueue(size_t capacity) : _capacity(capacity) {}
+
+    size_t size() const { return _events.size(); }
+    bool empty() const { return _events.empty(); }
+    const Event &front() const { return _events.front(); }
+
+    bool push(const Event &event) {
+        if (_events.size() >= _capacity) {
+            return false;
+        }
+        auto it = std::upper_bound(_events.begin(), _events.end(), event, EventCompare());
+        _events.insert(it, event);
+        return true;
+    }
+
+    bool pushReplace(const Event &event) {
+        auto it = std::upper_bound(_events.begin(), _events.end(), event, EventCompare());
+        _events.erase(it, _events.end());
+        return push(event);
+    }
+
+    void pop() {
+        _events.erase(_events.begin());
+    }
+
+private:
+    size_t _capacity;
+    std::vector<Event> _events;
+};
+
+// schedules gates the same way as NoteTrackEngine::triggerStep() with the maximum retrigger count
+template<typename Queue>
+static void triggerRetriggerStep(Queue &queue, uint32_t tick, uint32_t divisor, uint32_t gateOffset, int &id) {
+    int stepRetrigger = 4;
+    uint32_t stepLength = divisor;
+    uint32_t retriggerLength = divisor / stepRetrigger;
+    uint32_t retriggerOffset = 0;
+    while (stepRetrigger-- > 0 && retriggerOffset <= stepLength) {
+        queue.pushReplace({ tick + gateOffset + retriggerOffset, id++ });
+        queue.pushReplace({ tick + gateOffset + retriggerOffset + retriggerLength / 2, id++ });
+        retriggerOffset += retriggerLength;
+    }
+}
+
+UNIT_TEST("TimingWheel") {
+
+    CASE("empty") {
+        TimingWheel<Event, 16> queue;
+        expectTrue(queue.empty());
+        expectEqual(int(queue.size()), 0);
+        queue.pop();
+        expectTrue(queue.empty());
+        expectEqual(int(queue.overflow()), 0);
+    }
+
+    CASE("events with equal ticks are kept in order") {
+        TimingWheel<Event, 16> queue;
+        for (int i = 0; i < 8; ++i) {
+            queue.push({ 100, i });
+        }
+        for (int i = 0; i < 8; ++i) {
+            expectEqual(queue.front().id, i);
+            queue.pop();
+        }
+        expectTrue(queue.empty());
+    }
+
+    CASE("events beyond wheel span") {
+        TimingWheel<Event, 16> queue;
+        queue.push({ 1000 + 32 * 3, 0 });
+        queue.push({ 1000 + 32, 1 });
+        queue.push({ 1000, 2 });
+        queue.push({ 1000 + 32 * 2 + 1, 3 });
+        queue.pop();
+        expectEqual(queue.front().id, 1);
+        queue.pop();
+        expectEqual(queue.front().id, 3);
+        queue.pop();
+        expectEqual(queue.front().id, 0);
+        queue.pop();
+        expectTrue(queue.empty());
+    }
+
+    CASE("overflow keeps pending events") {
+        TimingWheel<Event, 8> queue;
+        for (int i = 0; i < 8; ++i) {
+            expectTrue(queue.push({ uint32_t(10 + i), i }));
+        }
+        expectTrue(queue.full());
+        expectTrue(!queue.push({ 5, 8 }));
+        expectEqual(int(queue.overflow()), 1);
+        expectEqual(int(queue.peak()), 8);
+        for (int i = 0; i < 8; ++i) {
+            expectEqual(queue.front().id, i);
+            queue.pop();
+        }
+        queue.resetStats();
+        expectEqual(int(queue.overflow()), 0);
+        expectEqual(int(queue.peak()), 0);
+    }
+
+    CASE("push replace removes later events") {
+        TimingWheel<Event, 16> queue;
+        queue.push({ 10, 0 });
+        queue.push({ 20, 1 });
+        queue.push({ 20 + 32, 2 });
+        queue.push({ 30, 3 });
+        queue.pushReplace({ 20, 4 });
+        expectEqual(int(queue.size()), 3);
+        expectEqual(queue.front().id, 0);
+        queue.pop();
+        expectEqual(queue.front().id, 1);
+        queue.pop();
+        expectEqual(queue.front().id, 4);
+        queue.pop();
+        expectTrue(queue.empty());
+    }
+
+    CASE("random operations match reference") {
+        Random rng(1234);
+        TimingWheel<Event, 32> queue;
+        ReferenceQueue reference(32);
+        uint32_t tick = 0;
+        int id = 0;
+
+        for (int i = 0; i < 1000000; ++i) {
+            tick += rng.nextRange(3);
+            uint32_t eventTick = tick + (rng.nextRange(8) == 0 ? rng.nextRange(1000) : rng.nextRange(48));
+            if (rng.nextRange(16) == 0 && eventTick >= 8) {
+                // events scheduled in the past
+                eventTick -= 8;
+            }
+            switch (rng.nextRange(3)) {
+            case 0:
+                expectEqual(queue.push({ eventTick, id }), reference.push({ eventTick, id }));
+                break;
+            case 1:
+                expectEqual(queue.pushReplace({ eventTick, id }), reference.pushReplace({ eventTick, id }));
+                break;
+            case 2:
+                while (!reference.empty() && tick >= reference.front().tick) {
+                    expectEqual(queue.front().id, reference.front().id);
+                    queue.pop();
+                    reference.pop();
+                }
+                break;
+            }
+            ++id;
+            expectEqual(queue.size(), reference.size());
+            if (!reference.empty()) {
+                expectEqual(queue.front().id, reference.front().id);
+            }
+        }
+    }
+
+    CASE("max retriggers on 64 steps at fastest divisor") {
+        // sequence divisor of 1 at 48 ppqn is 4 ticks at 192 ppqn
+        const uint32_t divisor = 4;
+        const int steps = 64;
+        const int loops = 1000;
+
+        TimingWheel<Event, 32> queue;
+        ReferenceQueue reference(32);
+        int id = 0;
+        int referenceId = 0;
+        int gates = 0;
+
+        for (uint32_t tick = 0; tick < divisor * steps * loops; ++tick) {
+            if (tick % divisor == 0) {
+                // alternate between maximum positive gate offset and none to overlap steps
+                uint32_t step = (tick / divisor) % steps;
+                uint32_t gateOffset = step % 2 == 0 ? (divisor * 7) / 8 : 0;
+                triggerRetriggerStep(queue, tick, divisor, gateOffset, id);
+                triggerRetriggerStep(reference, tick, divisor, gateOffset, referenceId);
+            }
+            while (!queue.empty() && tick >= queue.front().tick) {
+                expectFalse(reference.empty());
+                expectEqual(queue.front().id, reference.front().id);
+                queue.pop();
+                reference.pop();
+                ++gates;
+            }
+            expectTrue(reference.empty() || reference.front().tick > tick);
+        }
+
+        expectEqual(int(queue.overflow()), 0);
+        expectTrue(gates > 0);
+
+        DBG("%d gate events, peak queue size = %d", gates, int(queue.peak()));
+    }
+
+    CASE("benchmark") {
+        const uint32_t divisor = 4;
+        const uint32_t ticks = 1000000;
+        int id = 0;
+        volatile uint32_t sum = 0;
+        Timer timer;
+
+        timer.reset();
+        SortedQueue<Event, 32, EventCompare> sortedQueue;
+        for (uint32_t tick = 0; tick < ticks; ++tick) {
+            if (tick % divisor == 0) {
+                triggerRetriggerStep(sortedQueue, tick, divisor, (tick / divisor) % 2 ? 3 : 0, id);
+            }
+            while (!sortedQueue.empty() && tick >= sortedQueue.front().tick) {
+                sum = sum + sortedQueue.front().id;
+                sortedQueue.pop();
+            }
+        }
+        uint32_t sortedQueueTime = timer.elapsed();
+
+        timer.reset();
+        TimingWheel<Event, 32> timingWheel;
+        for (uint32_t tick = 0; tick < ticks; ++tick) {
+            if (tick % divisor == 0) {
+                triggerRetriggerStep(timingWheel, tick, divisor, (tick / divisor) % 2 ? 3 : 0, id);
+            }
+            while (!timingWheel.empty() && tick >= timingWheel.front().tick) {
+                sum = sum + timingWheel.front().id;
+                timingWheel.pop();
+            }
+        }
+        uint32_t timingWheelTime = timer.elapsed();
+
+        DBG("%d ticks: sorted queue = %.1f ns/tick, timing wheel = %.1f ns/tick",
+            ticks, sortedQueueTime * 1000.0 / ticks, timingWheelTime * 1000.0 / ticks);
+    }
+
+    CASE("benchmark out of order events") {
+        // keep a full queue of events scheduled in random order
+        const int events = 1000000;
+        volatile uint32_t sum = 0;
+        Timer timer;
+
+        Random sortedQueueRng(1);
+        SortedQueue<Event, 32, EventCompare> sortedQueue;
+        timer.reset();
+        for (int i = 0; i < events; ++i) {
+            if (sortedQueue.size() == 31) {
+                sum = sum + sortedQueue.front().id;
+                sortedQueue.pop();
+            }
+            sortedQueue.push({ i + sortedQueueRng.nextRange(1000), i });
+        }
+        uint32_t sortedQueueTime = timer.elapsed();
+
+        Random timingWheelRng(1);
+        TimingWheel<Event, 32> timingWheel;
+        timer.reset();
+        for (int i = 0; i < events; ++i) {
+            if (timingWheel.size() == 31) {
+                sum = sum + timingWheel.front().id;
+                timingWheel.pop();
+            }
+            timingWheel.push({ i + timingWheelRng.nextRange(1000), i });
+        }
+        uint32_t timingWheelTime = timer.elapsed();
+
+        DBG("%d events: sorted queue = %.1f ns/event, timing wheel = %.1f ns/event",
+            events, sortedQueueTime * 1000.0 / events, timingWheelTime * 1000.0 / events);
+    }
+}